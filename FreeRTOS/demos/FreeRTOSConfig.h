@@ -11,7 +11,7 @@
 /* Scheduler */
 #define configUSE_PREEMPTION                    1
 #define configUSE_TIME_SLICING                  1
-#define configUSE_IDLE_HOOK                     0
+#define configUSE_IDLE_HOOK                     configUSE_CO_ROUTINES
 #define configUSE_TICK_HOOK                     0
 #define configCPU_CLOCK_HZ                      3072000     /* 3.072 MHz */
 #define configTICK_RATE_HZ                      100         /* 100 Hz tick */
@@ -22,10 +22,116 @@
 #define configTICK_TYPE_WIDTH_IN_BITS           TICK_TYPE_WIDTH_16_BITS
 #define configIDLE_SHOULD_YIELD                 1
 
+/* Task selection from a ready-priority bitmap: make PORT_PRIO=1
+ * (port_prio.S) instead of walking pxReadyTasksLists down from the top.
+ * One bit per priority in UBaseType_t, so 8 priorities with an 8-bit
+ * type, 16 with a 16-bit one (checked in port_check.c). */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#endif
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION
+#ifndef __ASSEMBLER__
+extern const unsigned int uxPortPriorityBit[ 16 ];
+extern unsigned char ucPortHighestPriority8( unsigned char uxBitmap );
+extern unsigned char ucPortHighestPriority16( unsigned int uxBitmap );
+#endif
+#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) \
+    ( uxReadyPriorities ) |= ( UBaseType_t ) uxPortPriorityBit[ ( uxPriority ) ]
+#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) \
+    ( uxReadyPriorities ) &= ( UBaseType_t ) ~uxPortPriorityBit[ ( uxPriority ) ]
+#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) \
+    ( uxTopPriority ) = ( sizeof( uxReadyPriorities ) == 1 ) ?     \
+        ucPortHighestPriority8( ( unsigned char ) ( uxReadyPriorities ) ) : \
+        ucPortHighestPriority16( ( unsigned int ) ( uxReadyPriorities ) )
+#endif
+
+/* Kernel lists in assembly: make PORT_LIST=1 (port_list.S replaces
+ * list.c).  port_list.S hard-codes the list layout of this configuration:
+ * 16-bit ticks, the 16-bit UBaseType_t of portmacro.h (checked in
+ * port_check.c), mini list items and no integrity check bytes. */
+#ifndef configUSE_PORT_OPTIMISED_LIST
+#define configUSE_PORT_OPTIMISED_LIST           0
+#endif
+#if configUSE_PORT_OPTIMISED_LIST
+#if defined( configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES ) && configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES
+#error "port_list.S does not handle list integrity check bytes"
+#endif
+#if defined( configUSE_MINI_LIST_ITEM ) && ( configUSE_MINI_LIST_ITEM == 0 )
+#error "port_list.S expects configUSE_MINI_LIST_ITEM"
+#endif
+#endif
+
+/* Cooperative yield frames: make COOP_YIELD=1 (port_switch.S replaces
+ * portasm.S).  vPortYield saves only a tagged mask byte, since no
+ * register is live across the call; the restore skips the register POPs
+ * for such frames.  SHARE_MASK=1 also drops the per-task SIM mask: every
+ * task runs under the startup.S mask and must not change it. */
+#ifndef configPORT_COOPERATIVE_YIELD
+#define configPORT_COOPERATIVE_YIELD            0
+#endif
+#ifndef configPORT_TASKS_SHARE_MASK
+#define configPORT_TASKS_SHARE_MASK             0
+#endif
+#if configPORT_TASKS_SHARE_MASK && !configPORT_COOPERATIVE_YIELD
+#error "configPORT_TASKS_SHARE_MASK needs port_switch.S (COOP_YIELD=1)"
+#endif
+
+/* Tickless idle: make TICKLESS=1 (see tickless.c).  The idle task halts
+ * through the ticks until the next task is due; those ticks skip the
+ * kernel and are added back in one vTaskStepTick(). */
+#ifndef configUSE_TICKLESS_IDLE
+#define configUSE_TICKLESS_IDLE                 0
+#endif
+#if configUSE_TICKLESS_IDLE
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP   2
+#ifndef __ASSEMBLER__
+extern void vPortSuppressTicksAndSleep( unsigned int xExpectedIdleTime );
+#endif
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) \
+    vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+
+/* Interrupt levels (port_isr.h): 1 = RST 5.5, 2 = RST 6.5 (tick),
+ * 3 = RST 7.5.  Lines at or below the syscall level may use FromISR
+ * APIs and are masked through SIM by FromISR critical sections; lines
+ * above it stay live there but must not call the kernel.
+ * taskENTER_CRITICAL is DI unless make MASK_CRITICAL=1, which masks it
+ * through SIM too (portmacro.h, port_mask.S). */
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY    2
+#ifndef configPORT_MASK_CRITICAL
+#define configPORT_MASK_CRITICAL                0
+#endif
+#if configPORT_MASK_CRITICAL && configPORT_TASKS_SHARE_MASK
+#error "configPORT_MASK_CRITICAL needs each task's SIM mask in its frames"
+#endif
+#ifndef __ASSEMBLER__
+extern unsigned char ucPortRaiseMask( void );
+extern void vPortRestoreMask( unsigned char uxMask );
+#endif
+#define portSET_INTERRUPT_MASK_FROM_ISR()       ucPortRaiseMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )  vPortRestoreMask( ( unsigned char ) ( x ) )
+
+/* Stack sizes: declare task stacks with configSTACK_DEPTH( name ).
+ * make STACK_SIZES=<header> uses the sizes measured by
+ * tooling/freertos-stack-sizes.py, otherwise configMINIMAL_STACK_SIZE.
+ * New stacks are painted (INCLUDE_uxTaskGetStackHighWaterMark), so
+ * uxPortStackUnused() (port_stack.S) and the tool can measure them. */
+#ifdef configSTACK_SIZES_HEADER
+#include configSTACK_SIZES_HEADER
+#define configSTACK_DEPTH( xName )              STACK_SIZE_##xName
+#else
+#define configSTACK_DEPTH( xName )              configMINIMAL_STACK_SIZE
+#endif
+#ifndef __ASSEMBLER__
+extern unsigned int uxPortStackUnused( const void * pvStack, unsigned int uxBytes );
+#endif
+
 /* Memory allocation */
 #define configSUPPORT_STATIC_ALLOCATION         1
 #define configSUPPORT_DYNAMIC_ALLOCATION        1
-#define configTOTAL_HEAP_SIZE                   4096
+#ifndef configTOTAL_HEAP_SIZE
+#define configTOTAL_HEAP_SIZE                   4096        /* 1024 with COROUTINES=1 */
+#endif
 #define configAPPLICATION_ALLOCATED_HEAP        0
 
 /* Features */
@@ -41,11 +147,30 @@
 /* Timer */
 #define configUSE_TIMERS                        0
 
-/* Co-routines */
+/* Co-routines: make COROUTINES=1 (see coroutine.c).  Run-to-completion
+ * activities that all execute on the idle task's stack, scheduled from
+ * the idle hook; ordinary tasks run above them as usual. */
+#ifndef configUSE_CO_ROUTINES
 #define configUSE_CO_ROUTINES                   0
+#endif
+#if configUSE_CO_ROUTINES
+#define configMAX_CO_ROUTINE_PRIORITIES         2
+#if configUSE_TICKLESS_IDLE
+#error "Tickless idle does not see co-routine delays; build one or the other"
+#endif
+#endif
 
 /* Debug / trace */
 #define configUSE_TRACE_FACILITY                0
+
+/* Trace recorder: make TRACE_RECORDER=1 (see trace.h).  Kernel events
+ * go out through OUT instructions for the simulator to log. */
+#ifndef configUSE_TRACE_RECORDER
+#define configUSE_TRACE_RECORDER                0
+#endif
+#if configUSE_TRACE_RECORDER
+#include "trace.h"
+#endif
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 #define configCHECK_FOR_STACK_OVERFLOW          0
 #define configASSERT( x )
@@ -59,7 +184,7 @@
 #define INCLUDE_vTaskDelay                      1
 #define INCLUDE_xTaskGetSchedulerState          0
 #define INCLUDE_xTaskGetCurrentTaskHandle       0
-#define INCLUDE_uxTaskGetStackHighWaterMark     0
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
 #define INCLUDE_xResumeFromISR                  0
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,257 @@
+#!/usr/bin/env bash
+# FreeRTOS kernel timing benchmarks (demo_bench.c)
+#
+# Builds each scenario at two repetition counts, runs both through
+# i8085-trace and reports T-states (and instructions) per operation:
+#
+#   per_op = (clk[r2] - clk[r1]) / (ops[r2] - ops[r1])
+#
+# The two runs differ only in the loop count, so startup, scheduler start
+# and the final halt cancel exactly.  Scenarios 1-4 and 7 run without the
+# tick timer (nothing in them waits on time) so ticks don't pollute them.
+#
+#   rtos_yield        taskYIELD(), two equal-priority tasks
+#   rtos_yield_self   taskYIELD() with no other task at that priority
+#                     (save and restore of the same task)
+#   rtos_preempt      xTaskNotifyGive() -> higher-priority task runs and
+#                     blocks again (two context switches + notify/take)
+#   rtos_queue_rt     xQueueSend() + xQueueReceive(), 2-byte item
+#   rtos_mutex        contended mutex handover with priority inheritance
+#   rtos_tick_isr     one RST 6.5 tick with nothing to wake: busy loop
+#                     with the timer on minus the same loop with it off
+#   rtos_tick_wake    extra cost of a tick that wakes a higher-priority
+#                     task (vTaskDelay(1)) over a plain tick: wake in the
+#                     ISR, switch in, task runs and blocks, switch back
+#   rtos_irq75        one RST 7.5 interrupt (PORT_ISR_NESTED entry, C
+#                     handler, exit) taken while the task runs queue
+#                     round trips and taskENTER_CRITICAL() sections: loop
+#                     with the 7.5 timer on minus the same loop with it
+#                     off.  With MASK_CRITICAL=1, FAILED unless some were
+#                     taken inside the kernel's critical sections.
+#
+# Output matches tooling/examples/benchmark.sh
+# (benchmark,opt,text_bytes,instructions,clocks,status), with
+# instructions and clocks per operation; OUTPUT_FORMAT=csv|json|table.
+#
+# PORT_LIST=1 builds the kernel with port_list.S in place of list.c,
+# PORT_PRIO=1 with task selection from port_prio.S, and COOP_YIELD=1
+# (plus SHARE_MASK=1) with the cooperative frames of port_switch.S, and
+# MASK_CRITICAL=1 with SIM-mask kernel critical sections, each in its
+# own build tree, for comparison with a default run.
+#
+# Usage: bench.sh [-Oz|-O2|...]...   (default -Oz)
+set -euo pipefail
+
+DEMOS="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+ROOT="$(cd "${DEMOS}/../.." && pwd)"
+TOOLCHAIN="${ROOT}/llvm-project/build-clang-8085/bin"
+
+SIZE="${LLVM_SIZE:-${TOOLCHAIN}/llvm-size}"
+TRACE="${TRACE:-$ROOT/i8085-trace/build/i8085-trace}"
+MAKE="${MAKE:-make}"
+
+OUTPUT_FORMAT="${OUTPUT_FORMAT:-table}"  # table, csv or json
+TIMER="--timer=65:30720"                 # 100 Hz at 3.072 MHz, as make run
+TIMER75="--timer=75:${IRQ75_PERIOD:-3001}"  # ~1 kHz, not a loop multiple
+
+# Repetition counts: kernel ops, and busy-loop iterations for the tick
+# scenarios (long enough to span a couple of hundred ticks)
+OPS_R1="${OPS_R1:-100}"
+OPS_R2="${OPS_R2:-1100}"
+BUSY_R1="${BUSY_R1:-10000}"
+BUSY_R2="${BUSY_R2:-60000}"
+MAX_STEPS="${MAX_STEPS:-50000000}"
+PORT_LIST="${PORT_LIST:-0}"
+PORT_PRIO="${PORT_PRIO:-0}"
+COOP_YIELD="${COOP_YIELD:-0}"
+SHARE_MASK="${SHARE_MASK:-0}"
+MASK_CRITICAL="${MASK_CRITICAL:-0}"
+
+OPT_LEVELS=("$@")
+if [[ ${#OPT_LEVELS[@]} -eq 0 ]]; then
+  OPT_LEVELS=(-Oz)
+fi
+
+for tool in "${SIZE}" "${TRACE}"; do
+  if [[ ! -x "${tool}" ]]; then
+    echo "Error: missing tool ${tool}" >&2
+    exit 1
+  fi
+done
+
+# run <opt> <bench> <reps> <timer 0|1|75>: sets clk, steps, halt, text,
+# and the markers ops, ticks, wakes, inside
+run() {
+  local opt="$1" bench="$2" reps="$3" timer="$4"
+  local builddir="build/bench${opt}"
+  if [[ "${PORT_LIST}" -eq 1 ]]; then
+    builddir+="/list"
+  fi
+  if [[ "${PORT_PRIO}" -eq 1 ]]; then
+    builddir+="/prio"
+  fi
+  if [[ "${COOP_YIELD}" -eq 1 ]]; then
+    builddir+="/coop"
+  fi
+  if [[ "${SHARE_MASK}" -eq 1 ]]; then
+    builddir+="/share"
+  fi
+  if [[ "${MASK_CRITICAL}" -eq 1 ]]; then
+    builddir+="/mask"
+  fi
+  local bin="${DEMOS}/${builddir}/bench/freertos_bench_${bench}_${reps}.bin"
+  local elf="${bin%.bin}.elf"
+  local out="${bin%.bin}.t${timer}"
+
+  "${MAKE}" -s -C "${DEMOS}" bench-build OPT="${opt}" BUILDDIR="${builddir}" \
+    BENCH="${bench}" BENCH_REPS="${reps}" PORT_LIST="${PORT_LIST}" \
+    PORT_PRIO="${PORT_PRIO}" COOP_YIELD="${COOP_YIELD}" \
+    SHARE_MASK="${SHARE_MASK}" MASK_CRITICAL="${MASK_CRITICAL}" >&2
+
+  local trace_args=(-n "${MAX_STEPS}" -S -q -d 0xFE00:8)
+  if [[ "${timer}" -eq 1 ]]; then
+    trace_args=("${TIMER}" "${trace_args[@]}")
+  elif [[ "${timer}" -eq 75 ]]; then
+    trace_args=("${TIMER75}" "${trace_args[@]}")
+  fi
+  "${TRACE}" "${trace_args[@]}" "${bin}" > "${out}.json" 2> "${out}.dump.txt" || true
+
+  clk="$(grep -o '"clk":[0-9]*' "${out}.json" | cut -d: -f2)"
+  steps="$(grep -o '"steps":[0-9]*' "${out}.json" | cut -d: -f2)"
+  halt="$(grep -o '"halt":"[^"]*"' "${out}.json" | cut -d'"' -f4)"
+  text="$("${SIZE}" -A "${elf}" | awk '$1 == ".text" { print $2 }')"
+
+  # Dump line: "FE00: b0 .. b7 |........|"; markers are little-endian
+  local b
+  read -r -a b <<< "$(sed -n 's/^ *[0-9A-Fa-f]\{4\}: *\([^|]*\).*/\1/p' "${out}.dump.txt" | tr '\n' ' ')"
+  ops=$((16#${b[1]}${b[0]}))
+  ticks=$((16#${b[3]}${b[2]}))
+  wakes=$((16#${b[5]}${b[4]}))
+  inside=$((16#${b[7]}${b[6]}))
+}
+
+status_of() {
+  case "$1" in
+    hlt) echo HALTED ;;
+    max) echo TIMEOUT ;;
+    loop) echo LOOP ;;
+    *) echo "${1:-UNKNOWN}" ;;
+  esac
+}
+
+# Integer division rounded to nearest
+div() {
+  echo $(( ($1 * 2 + $2) / ($2 * 2) ))
+}
+
+declare -a RESULTS
+
+# emit <name> <opt> <text> <insns> <clocks> <status>
+emit() {
+  RESULTS+=("$1,${2#-},$3,$4,$5,$6")
+}
+
+bench_opt() {
+  local opt="$1"
+  local n name clk1 steps1 ops1 clk2 steps2 ops2 st text off offs
+  local names=(x rtos_yield rtos_preempt rtos_queue_rt rtos_mutex x x rtos_yield_self)
+
+  for n in 1 7 2 3 4; do
+    name="${names[$n]}"
+    run "${opt}" "${n}" "${OPS_R1}" 0
+    clk1="${clk}"; steps1="${steps}"; ops1="${ops}"; st="${halt}"
+    run "${opt}" "${n}" "${OPS_R2}" 0
+    clk2="${clk}"; steps2="${steps}"; ops2="${ops}"
+    [[ "${halt}" == hlt ]] || st="${halt}"
+    if [[ "${ops2}" -le "${ops1}" ]]; then
+      emit "${name}" "${opt}" "${text}" "?" "?" "FAILED"
+      continue
+    fi
+    emit "${name}" "${opt}" "${text}" \
+      "$(div $((steps2 - steps1)) $((ops2 - ops1)))" \
+      "$(div $((clk2 - clk1)) $((ops2 - ops1)))" "$(status_of "${st}")"
+  done
+
+  # RST 7.5 during kernel critical sections: same loop with and without
+  # its timer
+  run "${opt}" 8 "${OPS_R2}" 0
+  off="${clk}"; offs="${steps}"
+  run "${opt}" 8 "${OPS_R2}" 75
+  st="${halt}"
+  if [[ "${wakes}" -eq 0 ]] ||
+     [[ "${MASK_CRITICAL}" -eq 1 && "${inside}" -eq 0 ]]; then
+    emit rtos_irq75 "${opt}" "${text}" "?" "?" "FAILED"
+  else
+    emit rtos_irq75 "${opt}" "${text}" \
+      "$(div $((steps - offs)) "${wakes}")" \
+      "$(div $((clk - off)) "${wakes}")" "$(status_of "${st}")"
+  fi
+
+  # Tick ISR: same busy loop with and without the timer
+  local off1 off2 offs1 offs2 on_clk on_steps on_ticks tick_clk tick_steps
+  run "${opt}" 5 "${BUSY_R2}" 0
+  off2="${clk}"; offs2="${steps}"
+  run "${opt}" 5 "${BUSY_R2}" 1
+  on_clk="${clk}"; on_steps="${steps}"; on_ticks="${ticks}"; st="${halt}"
+  if [[ "${on_ticks}" -eq 0 ]]; then
+    emit rtos_tick_isr "${opt}" "${text}" "?" "?" "FAILED"
+    emit rtos_tick_wake "${opt}" "${text}" "?" "?" "FAILED"
+    return
+  fi
+  tick_clk="$(div $((on_clk - off2)) "${on_ticks}")"
+  tick_steps="$(div $((on_steps - offs2)) "${on_ticks}")"
+  emit rtos_tick_isr "${opt}" "${text}" "${tick_steps}" "${tick_clk}" "$(status_of "${st}")"
+
+  # Tick wake: busy loop + sleeper, minus the loop alone, minus the
+  # plain-tick share; differenced over two loop lengths
+  local w_clk1 w_steps1 w_ticks1 w_wakes1
+  run "${opt}" 5 "${BUSY_R1}" 0
+  off1="${clk}"; offs1="${steps}"
+  run "${opt}" 6 "${BUSY_R1}" 1
+  w_clk1="${clk}"; w_steps1="${steps}"; w_ticks1="${ticks}"; w_wakes1="${wakes}"
+  run "${opt}" 6 "${BUSY_R2}" 1
+  st="${halt}"
+  if [[ "${wakes}" -le "${w_wakes1}" ]]; then
+    emit rtos_tick_wake "${opt}" "${text}" "?" "?" "FAILED"
+    return
+  fi
+  emit rtos_tick_wake "${opt}" "${text}" \
+    "$(div $(( (steps - w_steps1) - (offs2 - offs1) - (ticks - w_ticks1) * tick_steps )) $((wakes - w_wakes1)))" \
+    "$(div $(( (clk - w_clk1) - (off2 - off1) - (ticks - w_ticks1) * tick_clk )) $((wakes - w_wakes1)))" \
+    "$(status_of "${st}")"
+}
+
+for opt in "${OPT_LEVELS[@]}"; do
+  bench_opt "${opt}"
+done
+
+case "${OUTPUT_FORMAT}" in
+  csv)
+    echo "benchmark,opt,text_bytes,instructions,clocks,status"
+    printf "%s\n" "${RESULTS[@]}"
+    ;;
+  json)
+    echo "["
+    for i in "${!RESULTS[@]}"; do
+      IFS=',' read -r bench opt text insns clocks status <<< "${RESULTS[$i]}"
+      sep=","
+      [[ $i -eq $((${#RESULTS[@]} - 1)) ]] && sep=""
+      printf '  {"benchmark":"%s","opt":"%s","text_bytes":"%s","instructions":"%s","clocks":"%s","status":"%s"}%s\n' \
+        "${bench}" "${opt}" "${text}" "${insns}" "${clocks}" "${status}" "${sep}"
+    done
+    echo "]"
+    ;;
+  *)
+    printf "%-15s %-3s %10s %12s %11s %-8s\n" "Benchmark" "Opt" "Text(bytes)" "Insns/op" "Clocks/op" "Status"
+    for r in "${RESULTS[@]}"; do
+      IFS=',' read -r bench opt text insns clocks status <<< "${r}"
+      printf "%-15s %-3s %10s %12s %11s %-8s\n" "${bench}" "${opt}" "${text}" "${insns}" "${clocks}" "${status}"
+    done
+    ;;
+esac
+
+failures=0
+for r in "${RESULTS[@]}"; do
+  [[ "${r##*,}" == HALTED ]] || failures=$((failures + 1))
+done
+exit $((failures > 0))
@@ -0,0 +1,32 @@
+/*
+ * FreeRTOS Intel 8085 - shared-stack co-routines (make COROUTINES=1)
+ *
+ * A task costs a TCB and its own stack (configMINIMAL_STACK_SIZE, 256
+ * bytes).  A co-routine (croutine.h) costs only its control block, about
+ * 30 bytes from the heap: all co-routines run one at a time on the idle
+ * task's stack, so each one must finish its step and return to the
+ * scheduler instead of being switched out.
+ *
+ * Rules that follow from the shared stack:
+ *   - crDELAY, crQUEUE_SEND and crQUEUE_RECEIVE only at the top level of
+ *     the co-routine function, never from a function it calls;
+ *   - locals do not survive a blocking call: keep state in statics,
+ *     indexed by uxIndex when one function serves several co-routines;
+ *   - a co-routine runs only when no task is ready, and never preempts
+ *     another co-routine.
+ *
+ * Ordinary preemptive tasks are unaffected.  Tickless idle is not
+ * available in this mode (FreeRTOSConfig.h): the idle task would sleep
+ * through co-routine delays.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "croutine.h"
+
+/* Applications that need their own idle work call vCoRoutineSchedule()
+ * from it instead; each call runs at most one co-routine step. */
+void vApplicationIdleHook( void )
+{
+    vCoRoutineSchedule();
+}
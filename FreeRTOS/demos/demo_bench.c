@@ -0,0 +1,414 @@
+/*
+ * FreeRTOS Intel 8085 demo - kernel timing benchmarks
+ *
+ * One scenario per build, picked with -DBENCH=n; -DBENCH_REPS=r sets how
+ * many times its operation runs.  Every scenario ends in DI; HLT, so the
+ * simulator's total T-state count ("clk" in the -S summary) covers the
+ * whole run.  bench.sh builds each scenario at two repetition counts
+ * and divides the clock difference by the operation-count difference,
+ * which cancels startup, scheduler start and the final halt exactly
+ * (the simulator is deterministic).
+ *
+ *   BENCH  scenario                 one operation
+ *   1      yield                    taskYIELD() from one of two equal-
+ *                                   priority tasks (one context switch)
+ *   2      notify_preempt           xTaskNotifyGive() to a blocked
+ *                                   higher-priority task, which runs,
+ *                                   takes the notification and blocks
+ *                                   again (two switches)
+ *   3      queue_roundtrip          xQueueSend() + xQueueReceive() of a
+ *                                   2-byte item, no blocking
+ *   4      mutex_contention         low-priority owner wakes a higher-
+ *                                   priority task that blocks on the
+ *                                   mutex (priority inheritance), then
+ *                                   gives it; the waiter takes, gives and
+ *                                   blocks again
+ *   5      busy                     BENCH_REPS iterations of a busy loop,
+ *                                   no other task ready: run with and
+ *                                   without the tick timer to get the
+ *                                   cost of one tick ISR
+ *   6      tick_wake                the busy loop of 5 plus a higher-
+ *                                   priority task in vTaskDelay(1): each
+ *                                   tick wakes it (ISR -> task switch),
+ *                                   it runs and blocks again
+ *   7      yield_self               taskYIELD() with no other task ready
+ *                                   at that priority: full save, select,
+ *                                   restore of the same task
+ *   8      irq75                    xQueueSend() + xQueueReceive() + a
+ *                                   taskENTER_CRITICAL() section, with
+ *                                   RST 7.5 unmasked: run with and
+ *                                   without a 7.5 timer to get the cost
+ *                                   of one 7.5 interrupt taken through
+ *                                   PORT_ISR_NESTED, and (MASK_CRITICAL=1)
+ *                                   how many landed inside the kernel's
+ *                                   critical sections
+ *
+ * Markers:
+ *   0xFE00: operations completed
+ *   0xFE02: tick count at the end (xTaskGetTickCount)
+ *   0xFE04: tick_wake: wakeups of the delayed task; irq75: 7.5 handler runs
+ *   0xFE06: irq75: handler runs that interrupted a kernel critical
+ *           section (MASK_CRITICAL=1; with DI none can)
+ *
+ * Run: bench.sh (CSV/JSON); single scenario:
+ *   make bench-build BENCH=1 BENCH_REPS=100
+ *   i8085-trace --timer=65:30720 -n 20000000 -S -d 0xFE00:8 \
+ *       build/bench/freertos_bench_1_100.bin
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#ifndef BENCH
+#define BENCH 1
+#endif
+#ifndef BENCH_REPS
+#define BENCH_REPS 100
+#endif
+
+/* Memory-mapped markers */
+#define MARKER_OPS    ( *( volatile unsigned int * ) 0xFE00 )
+#define MARKER_TICKS  ( *( volatile unsigned int * ) 0xFE02 )
+#define MARKER_WAKES  ( *( volatile unsigned int * ) 0xFE04 )
+#define MARKER_INSIDE ( *( volatile unsigned int * ) 0xFE06 )
+
+/* Task storage */
+static StaticTask_t xTaskA_TCB;
+static StackType_t  xTaskA_Stack[ configMINIMAL_STACK_SIZE ];
+
+static StaticTask_t xTaskB_TCB;
+static StackType_t  xTaskB_Stack[ configMINIMAL_STACK_SIZE ];
+
+static StaticTask_t xIdleTaskTCB;
+static StackType_t  xIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+static TaskHandle_t xTaskB;
+
+/*-----------------------------------------------------------
+ * Required by FreeRTOS static allocation
+ *-----------------------------------------------------------*/
+void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                    StackType_t ** ppxIdleTaskStackBuffer,
+                                    configSTACK_DEPTH_TYPE * pulIdleTaskStackSize )
+{
+    *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+    *ppxIdleTaskStackBuffer = xIdleTaskStack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+/*-----------------------------------------------------------
+ * Stop the simulator: the summary's clk is the benchmark result
+ *-----------------------------------------------------------*/
+static void prvBenchDone( void )
+{
+    MARKER_TICKS = ( unsigned int ) xTaskGetTickCount();
+
+    /* Not taskDISABLE_INTERRUPTS(): with MASK_CRITICAL=1 that leaves RST
+     * 7.5 live and it would wake the HLT. */
+    __asm__ volatile ( "di" );
+
+    for( ;; )
+    {
+        __asm__ volatile ( "hlt" );
+    }
+}
+
+#if BENCH == 1
+/*-----------------------------------------------------------
+ * 1: taskYIELD between two equal-priority tasks
+ *-----------------------------------------------------------*/
+static volatile unsigned char ucFinished;
+
+static void vYielder( void * pvParameters )
+{
+    unsigned int i;
+
+    ( void ) pvParameters;
+
+    for( i = 0; i < BENCH_REPS; i++ )
+    {
+        taskYIELD();
+        MARKER_OPS++;
+    }
+
+    if( ++ucFinished == 2 )
+    {
+        prvBenchDone();
+    }
+
+    for( ;; )
+    {
+        taskYIELD();
+    }
+}
+
+static void prvCreateTasks( void )
+{
+    xTaskCreateStatic( vYielder, "YldA", configMINIMAL_STACK_SIZE, NULL, 1,
+                       xTaskA_Stack, &xTaskA_TCB );
+    xTaskCreateStatic( vYielder, "YldB", configMINIMAL_STACK_SIZE, NULL, 1,
+                       xTaskB_Stack, &xTaskB_TCB );
+}
+
+#elif BENCH == 2
+/*-----------------------------------------------------------
+ * 2: notification to a blocked higher-priority task
+ *-----------------------------------------------------------*/
+static void vWaiter( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ;; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        MARKER_OPS++;
+    }
+}
+
+static void vNotifier( void * pvParameters )
+{
+    unsigned int i;
+
+    ( void ) pvParameters;
+
+    for( i = 0; i < BENCH_REPS; i++ )
+    {
+        xTaskNotifyGive( xTaskB );
+    }
+
+    prvBenchDone();
+}
+
+static void prvCreateTasks( void )
+{
+    xTaskB = xTaskCreateStatic( vWaiter, "Wait", configMINIMAL_STACK_SIZE,
+                                NULL, 2, xTaskB_Stack, &xTaskB_TCB );
+    xTaskCreateStatic( vNotifier, "Ntfy", configMINIMAL_STACK_SIZE, NULL, 1,
+                       xTaskA_Stack, &xTaskA_TCB );
+}
+
+#elif BENCH == 3
+/*-----------------------------------------------------------
+ * 3: queue send/receive round trip in one task
+ *-----------------------------------------------------------*/
+static StaticQueue_t xQueueBuffer;
+static unsigned char ucQueueStorage[ 4 * sizeof( unsigned int ) ];
+static QueueHandle_t xQueue;
+
+static void vQueueUser( void * pvParameters )
+{
+    unsigned int i;
+    unsigned int uValue;
+
+    ( void ) pvParameters;
+
+    for( i = 0; i < BENCH_REPS; i++ )
+    {
+        uValue = i;
+        ( void ) xQueueSend( xQueue, &uValue, 0 );
+        ( void ) xQueueReceive( xQueue, &uValue, 0 );
+        MARKER_OPS += ( uValue == i );
+    }
+
+    prvBenchDone();
+}
+
+static void prvCreateTasks( void )
+{
+    xQueue = xQueueCreateStatic( 4, sizeof( unsigned int ), ucQueueStorage,
+                                 &xQueueBuffer );
+    xTaskCreateStatic( vQueueUser, "Queue", configMINIMAL_STACK_SIZE, NULL, 1,
+                       xTaskA_Stack, &xTaskA_TCB );
+}
+
+#elif BENCH == 4
+/*-----------------------------------------------------------
+ * 4: mutex handover under contention
+ *-----------------------------------------------------------*/
+static StaticSemaphore_t xMutexBuffer;
+static SemaphoreHandle_t xMutex;
+
+static void vContender( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ;; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        ( void ) xSemaphoreTake( xMutex, portMAX_DELAY );
+        MARKER_OPS++;
+        ( void ) xSemaphoreGive( xMutex );
+    }
+}
+
+static void vOwner( void * pvParameters )
+{
+    unsigned int i;
+
+    ( void ) pvParameters;
+
+    for( i = 0; i < BENCH_REPS; i++ )
+    {
+        ( void ) xSemaphoreTake( xMutex, portMAX_DELAY );
+        xTaskNotifyGive( xTaskB );   /* contender runs, blocks on the mutex */
+        ( void ) xSemaphoreGive( xMutex );
+    }
+
+    prvBenchDone();
+}
+
+static void prvCreateTasks( void )
+{
+    xMutex = xSemaphoreCreateMutexStatic( &xMutexBuffer );
+    xTaskB = xTaskCreateStatic( vContender, "Cont", configMINIMAL_STACK_SIZE,
+                                NULL, 2, xTaskB_Stack, &xTaskB_TCB );
+    xTaskCreateStatic( vOwner, "Own", configMINIMAL_STACK_SIZE, NULL, 1,
+                       xTaskA_Stack, &xTaskA_TCB );
+}
+
+#elif BENCH == 5 || BENCH == 6
+/*-----------------------------------------------------------
+ * 5: busy loop alone (tick ISR cost)
+ * 6: busy loop + task woken by every tick
+ *-----------------------------------------------------------*/
+static volatile unsigned int uSink;
+
+static void vBusy( void * pvParameters )
+{
+    unsigned int i;
+
+    ( void ) pvParameters;
+
+    for( i = 0; i < BENCH_REPS; i++ )
+    {
+        uSink += i;
+        MARKER_OPS++;
+    }
+
+    prvBenchDone();
+}
+
+#if BENCH == 6
+static void vSleeper( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ;; )
+    {
+        vTaskDelay( 1 );
+        MARKER_WAKES++;
+    }
+}
+#endif
+
+static void prvCreateTasks( void )
+{
+    xTaskCreateStatic( vBusy, "Busy", configMINIMAL_STACK_SIZE, NULL, 1,
+                       xTaskA_Stack, &xTaskA_TCB );
+#if BENCH == 6
+    xTaskCreateStatic( vSleeper, "Slp", configMINIMAL_STACK_SIZE, NULL, 2,
+                       xTaskB_Stack, &xTaskB_TCB );
+#endif
+}
+
+#elif BENCH == 7
+/*-----------------------------------------------------------
+ * 7: taskYIELD with nothing else to run
+ *-----------------------------------------------------------*/
+static void vLoneYielder( void * pvParameters )
+{
+    unsigned int i;
+
+    ( void ) pvParameters;
+
+    for( i = 0; i < BENCH_REPS; i++ )
+    {
+        taskYIELD();
+        MARKER_OPS++;
+    }
+
+    prvBenchDone();
+}
+
+static void prvCreateTasks( void )
+{
+    xTaskCreateStatic( vLoneYielder, "Yld", configMINIMAL_STACK_SIZE, NULL, 1,
+                       xTaskA_Stack, &xTaskA_TCB );
+}
+
+#elif BENCH == 8
+/*-----------------------------------------------------------
+ * 8: queue round trips, RST 7.5 live.  The task spends most of its time
+ * in the kernel's own critical sections (xQueueSend/xQueueReceive and a
+ * taskENTER_CRITICAL of its own): DI by default, SIM masks with
+ * MASK_CRITICAL=1.
+ *-----------------------------------------------------------*/
+static StaticQueue_t xQueueBuffer;
+static unsigned char ucQueueStorage[ 4 * sizeof( unsigned int ) ];
+static QueueHandle_t xQueue;
+static volatile unsigned int uSink;
+
+void vApplicationIRQHandler75( void )
+{
+    MARKER_WAKES++;
+#if configPORT_MASK_CRITICAL
+    MARKER_INSIDE += ( ucPortCriticalNesting != 0 );
+#endif
+}
+
+static void vCritical( void * pvParameters )
+{
+    unsigned int i;
+    unsigned int uValue = 0;
+
+    ( void ) pvParameters;
+
+    /* Tasks start with 5.5 and 7.5 masked; unmask 7.5 for this one */
+    vPortRestoreMask( 0x09 );
+
+    for( i = 0; i < BENCH_REPS; i++ )
+    {
+        ( void ) xQueueSend( xQueue, &uValue, 0 );
+        ( void ) xQueueReceive( xQueue, &uValue, 0 );
+        taskENTER_CRITICAL();
+        uSink += uValue + i;
+        taskEXIT_CRITICAL();
+        MARKER_OPS++;
+    }
+
+    prvBenchDone();
+}
+
+static void prvCreateTasks( void )
+{
+    xQueue = xQueueCreateStatic( 4, sizeof( unsigned int ), ucQueueStorage,
+                                 &xQueueBuffer );
+    xTaskCreateStatic( vCritical, "Crit", configMINIMAL_STACK_SIZE, NULL, 1,
+                       xTaskA_Stack, &xTaskA_TCB );
+}
+
+#else
+#error "BENCH must be 1..8"
+#endif
+
+/*-----------------------------------------------------------
+ * main
+ *-----------------------------------------------------------*/
+int main( void )
+{
+    MARKER_OPS = 0;
+    MARKER_TICKS = 0;
+    MARKER_WAKES = 0;
+    MARKER_INSIDE = 0;
+
+    prvCreateTasks();
+
+    /* Start scheduler - never returns */
+    vTaskStartScheduler();
+
+    for( ;; )
+    {
+    }
+}
@@ -0,0 +1,259 @@
+/*
+ * FreeRTOS Intel 8085 demo - 24 co-routines on one shared stack
+ *
+ * Build and run with: make run-coro  (COROUTINES=1, see coroutine.c)
+ *
+ * 22 "blinker" co-routines share one function and run every
+ * 3..9 ticks (period from uxIndex), counting their runs; a producer and
+ * a consumer co-routine pass a sequence through a co-routine queue.  All
+ * 24 execute on the idle task's stack.  One ordinary preemptive task
+ * sleeps CORO_TICKS ticks, then checks every blinker's count and the
+ * queue sequence, and ends the run.
+ *
+ * RAM for the 24 activities, counted by the checker at the end of the
+ * run and held to CORO_RAM_BUDGET (an error otherwise):
+ *   - the heap they took: control blocks and the queue (0xFE02);
+ *   - their state here and croutine.c's lists, placed between
+ *     _scorobss and _ecorobss by linker.ld;
+ *   - the deepest use of the shared stack, the idle task's
+ *     CORO_SHARED_STACK bytes (0xFE0A), which the idle task needs anyway.
+ * Not counted: the idle TCB, which every build has, and the checker's
+ * TCB and stack, which only test the run.  As tasks, each activity would
+ * need a 256-byte stack and a TCB.  COROUTINES=1 also shrinks the heap
+ * to 1024 bytes (Makefile).
+ *
+ * Markers:
+ *   0xFE00: co-routines created (CORO_COUNT)
+ *   0xFE02: heap bytes taken by the co-routines and their queue
+ *   0xFE04: errors (blinker off its expected count, sequence break,
+ *           RAM over CORO_RAM_BUDGET, shared stack used up)
+ *   0xFE06: total co-routine steps run
+ *   0xFE08: RAM counted for the 24 activities (heap + .bss + stack)
+ *   0xFE0A: shared stack bytes used (high-water mark)
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "croutine.h"
+
+#define CORO_BLINKERS   22
+#define CORO_COUNT      ( CORO_BLINKERS + 2 )
+#define CORO_TICKS      140
+#define CORO_RAM_BUDGET 1024
+
+/* The idle task's stack, on which every co-routine step runs */
+#define CORO_SHARED_STACK   128
+
+#define MARKER_CREATED  ( *( volatile unsigned int * ) 0xFE00 )
+#define MARKER_HEAP     ( *( volatile unsigned int * ) 0xFE02 )
+#define MARKER_ERRORS   ( *( volatile unsigned int * ) 0xFE04 )
+#define MARKER_STEPS    ( *( volatile unsigned int * ) 0xFE06 )
+#define MARKER_RAM      ( *( volatile unsigned int * ) 0xFE08 )
+#define MARKER_STACK    ( *( volatile unsigned int * ) 0xFE0A )
+
+/* Co-routine state goes between _scorobss and _ecorobss (linker.ld) */
+#define CORO_STATE      __attribute__( ( section( ".bss.coro" ) ) )
+extern unsigned char _scorobss[];
+extern unsigned char _ecorobss[];
+
+/* Blinker i runs every prvPeriod( i ) ticks */
+#define prvPeriod( uxIndex )    ( ( TickType_t ) ( 3 + ( ( uxIndex ) % 7 ) ) )
+
+/* Task storage */
+static StaticTask_t xCheckTCB;
+static StackType_t  xCheckStack[ configMINIMAL_STACK_SIZE ];
+
+/* Also the stack every co-routine runs on */
+static StaticTask_t xIdleTaskTCB;
+static StackType_t  xIdleTaskStack[ CORO_SHARED_STACK ];
+
+/* Co-routine state: locals do not survive a block, so it lives here */
+static CORO_STATE unsigned int uRuns[ CORO_BLINKERS ];
+static CORO_STATE QueueHandle_t xSeqQueue;
+static CORO_STATE unsigned char ucReceived;
+
+/*-----------------------------------------------------------
+ * Required by FreeRTOS static allocation
+ *-----------------------------------------------------------*/
+void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                    StackType_t ** ppxIdleTaskStackBuffer,
+                                    configSTACK_DEPTH_TYPE * pulIdleTaskStackSize )
+{
+    *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+    *ppxIdleTaskStackBuffer = xIdleTaskStack;
+    *pulIdleTaskStackSize = CORO_SHARED_STACK;
+}
+
+/*-----------------------------------------------------------
+ * Co-routines
+ *-----------------------------------------------------------*/
+static void vBlinker( CoRoutineHandle_t xHandle,
+                      UBaseType_t uxIndex )
+{
+    crSTART( xHandle );
+
+    for( ;; )
+    {
+        crDELAY( xHandle, prvPeriod( uxIndex ) );
+        uRuns[ uxIndex ]++;
+        MARKER_STEPS++;
+    }
+
+    crEND();
+}
+
+static void vProducer( CoRoutineHandle_t xHandle,
+                       UBaseType_t uxIndex )
+{
+    static CORO_STATE unsigned char ucNext;
+    static CORO_STATE BaseType_t xResult;
+
+    ( void ) uxIndex;
+
+    crSTART( xHandle );
+
+    for( ;; )
+    {
+        crQUEUE_SEND( xHandle, xSeqQueue, &ucNext, portMAX_DELAY, &xResult );
+
+        if( xResult == pdPASS )
+        {
+            ucNext++;
+        }
+
+        MARKER_STEPS++;
+        crDELAY( xHandle, 2 );
+    }
+
+    crEND();
+}
+
+static void vConsumer( CoRoutineHandle_t xHandle,
+                       UBaseType_t uxIndex )
+{
+    static CORO_STATE unsigned char ucByte;
+    static CORO_STATE BaseType_t xResult;
+
+    ( void ) uxIndex;
+
+    crSTART( xHandle );
+
+    for( ;; )
+    {
+        crQUEUE_RECEIVE( xHandle, xSeqQueue, &ucByte, portMAX_DELAY, &xResult );
+
+        if( xResult == pdPASS )
+        {
+            if( ucByte != ucReceived )
+            {
+                MARKER_ERRORS++;
+            }
+
+            ucReceived = ( unsigned char ) ( ucByte + 1 );
+            MARKER_STEPS++;
+        }
+    }
+
+    crEND();
+}
+
+/*-----------------------------------------------------------
+ * Ordinary preemptive task: checks the co-routines, ends the run
+ *-----------------------------------------------------------*/
+static void vChecker( void * pvParameters )
+{
+    UBaseType_t i;
+    unsigned int uExpected;
+    unsigned int uUnused;
+
+    ( void ) pvParameters;
+
+    vTaskDelay( CORO_TICKS );
+
+    /* Preempts the idle task, so a blinker due this very tick may not
+     * have run yet */
+    for( i = 0; i < CORO_BLINKERS; i++ )
+    {
+        uExpected = CORO_TICKS / prvPeriod( i );
+
+        if( ( uRuns[ i ] != uExpected ) && ( uRuns[ i ] + 1 != uExpected ) )
+        {
+            MARKER_ERRORS++;
+        }
+    }
+
+    /* One item every 2 ticks, allowing for the one in flight */
+    if( ucReceived + 1 < CORO_TICKS / 2 )
+    {
+        MARKER_ERRORS++;
+    }
+
+    /* The idle task is preempted here, so its saved frame is on the
+     * shared stack too.  A stack with no paint left may have overflowed. */
+    uUnused = uxPortStackUnused( xIdleTaskStack, sizeof( xIdleTaskStack ) );
+    MARKER_STACK = sizeof( xIdleTaskStack ) - uUnused;
+    MARKER_RAM = MARKER_HEAP + ( unsigned int ) ( _ecorobss - _scorobss ) + MARKER_STACK;
+
+    if( ( uUnused == 0 ) || ( MARKER_RAM > CORO_RAM_BUDGET ) )
+    {
+        MARKER_ERRORS++;
+    }
+
+    taskDISABLE_INTERRUPTS();
+
+    for( ;; )
+    {
+        __asm__ volatile ( "hlt" );
+    }
+}
+
+/*-----------------------------------------------------------
+ * main
+ *-----------------------------------------------------------*/
+int main( void )
+{
+    size_t xHeapBefore;
+    UBaseType_t i;
+
+    MARKER_CREATED = 0;
+    MARKER_HEAP = 0;
+    MARKER_ERRORS = 0;
+    MARKER_STEPS = 0;
+    MARKER_RAM = 0;
+    MARKER_STACK = 0;
+
+    xHeapBefore = xPortGetFreeHeapSize();
+
+    xSeqQueue = xQueueCreate( 4, sizeof( unsigned char ) );
+
+    for( i = 0; i < CORO_BLINKERS; i++ )
+    {
+        if( xCoRoutineCreate( vBlinker, 0, i ) == pdPASS )
+        {
+            MARKER_CREATED++;
+        }
+    }
+
+    if( xCoRoutineCreate( vProducer, 0, 0 ) == pdPASS )
+    {
+        MARKER_CREATED++;
+    }
+
+    if( xCoRoutineCreate( vConsumer, 1, 0 ) == pdPASS )
+    {
+        MARKER_CREATED++;
+    }
+
+    MARKER_HEAP = ( unsigned int ) ( xHeapBefore - xPortGetFreeHeapSize() );
+
+    xTaskCreateStatic( vChecker, "Chk", configMINIMAL_STACK_SIZE, NULL, 1,
+                       xCheckStack, &xCheckTCB );
+
+    /* Start scheduler - never returns */
+    vTaskStartScheduler();
+
+    for( ;; )
+    {
+    }
+}
@@ -0,0 +1,103 @@
+/*
+ * FreeRTOS Intel 8085 demo - mostly idle system (tickless idle check)
+ *
+ * One task wakes every IDLE_PERIOD ticks with vTaskDelay(), records the
+ * tick count and goes back to sleep; the CPU is otherwise idle.  Build
+ * it twice and compare the simulator summaries:
+ *
+ *   make run-idle               idle task spins, every tick runs the
+ *                               full tick ISR
+ *   make run-idle TICKLESS=1    idle task halts, ticks in between only
+ *                               counted (tickless.c)
+ *
+ * Both runs cover the same simulated time (the last wake ends it), so
+ * "steps" is the work the CPU did; with TICKLESS=1 it drops to the
+ * task's own work plus a few instructions per tick.
+ *
+ * Markers:
+ *   0xFE00: wakes completed (IDLE_WAKES at the end)
+ *   0xFE02: tick count at the last wake (IDLE_WAKES * IDLE_PERIOD)
+ *   0xFE04: wakes that saw the wrong tick count (0 = no drift)
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define IDLE_PERIOD     10
+#define IDLE_WAKES      20
+
+#define MARKER_WAKES    ( *( volatile unsigned int * ) 0xFE00 )
+#define MARKER_TICKS    ( *( volatile unsigned int * ) 0xFE02 )
+#define MARKER_ERRORS   ( *( volatile unsigned int * ) 0xFE04 )
+
+/* Task storage */
+static StaticTask_t xTaskTCB;
+static StackType_t  xTaskStack[ configMINIMAL_STACK_SIZE ];
+
+static StaticTask_t xIdleTaskTCB;
+static StackType_t  xIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+/*-----------------------------------------------------------
+ * Required by FreeRTOS static allocation
+ *-----------------------------------------------------------*/
+void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                    StackType_t ** ppxIdleTaskStackBuffer,
+                                    configSTACK_DEPTH_TYPE * pulIdleTaskStackSize )
+{
+    *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+    *ppxIdleTaskStackBuffer = xIdleTaskStack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+/*-----------------------------------------------------------
+ * Periodic task
+ *-----------------------------------------------------------*/
+static void vPeriodic( void * pvParameters )
+{
+    TickType_t xNow;
+    unsigned int i;
+
+    ( void ) pvParameters;
+
+    for( i = 1; i <= IDLE_WAKES; i++ )
+    {
+        vTaskDelay( IDLE_PERIOD );
+
+        xNow = xTaskGetTickCount();
+        MARKER_TICKS = ( unsigned int ) xNow;
+
+        if( xNow != ( TickType_t ) ( i * IDLE_PERIOD ) )
+        {
+            MARKER_ERRORS++;
+        }
+
+        MARKER_WAKES++;
+    }
+
+    taskDISABLE_INTERRUPTS();
+
+    for( ;; )
+    {
+        __asm__ volatile ( "hlt" );
+    }
+}
+
+/*-----------------------------------------------------------
+ * main
+ *-----------------------------------------------------------*/
+int main( void )
+{
+    MARKER_WAKES = 0;
+    MARKER_TICKS = 0;
+    MARKER_ERRORS = 0;
+
+    xTaskCreateStatic( vPeriodic, "Per", configMINIMAL_STACK_SIZE, NULL, 1,
+                       xTaskStack, &xTaskTCB );
+
+    /* Start scheduler - never returns */
+    vTaskStartScheduler();
+
+    for( ;; )
+    {
+    }
+}
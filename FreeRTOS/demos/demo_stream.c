@@ -0,0 +1,235 @@
+/*
+ * FreeRTOS Intel 8085 demo - ISR-to-task byte stream throughput
+ *
+ * RST 5.5 stands in for a UART receive interrupt: the simulator fires it
+ * every STREAM_PERIOD T-states (--timer=55:P) and the handler pushes the
+ * next byte of a counting sequence to a receiver task.  The receiver
+ * checks the sequence; a low-priority background task soaks up the rest
+ * of the CPU, as application work would.  The receiver polls once per
+ * tick at worst, so both buffers hold 128 bytes: a full tick of input
+ * down to a 240 T-state period, leaving the ISR cost as the limit.
+ *
+ *   default          ring buffer (ringbuf.h): xRingBufferPutFromISR in
+ *                    the ISR, zero-copy spans in the task
+ *   -DSTREAM_QUEUE   xQueueSendFromISR / xQueueReceive of 1-byte items
+ *
+ * The run ends once STREAM_BYTES bytes have been offered.  Bytes that did
+ * not fit are counted as dropped; at 9600 baud (3.072 MHz) a byte arrives
+ * every 3200 T-states.  stream_bench.sh sweeps the period for both
+ * variants.
+ *
+ * Markers:
+ *   0xFE00: bytes received
+ *   0xFE02: bytes dropped
+ *   0xFE04: sequence errors (received byte != expected, after drops)
+ *   0xFE06: background loop count (CPU left for the application)
+ *   0xFE08: receiver stack bytes never used (uxPortStackUnused)
+ *
+ * Stacks take their sizes from configSTACK_DEPTH: make stacks-stream
+ * measures them.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "ringbuf.h"
+
+#ifndef STREAM_BYTES
+#define STREAM_BYTES    2000
+#endif
+
+#define MARKER_RX       ( *( volatile unsigned int * ) 0xFE00 )
+#define MARKER_DROPPED  ( *( volatile unsigned int * ) 0xFE02 )
+#define MARKER_ERRORS   ( *( volatile unsigned int * ) 0xFE04 )
+#define MARKER_BG       ( *( volatile unsigned int * ) 0xFE06 )
+#define MARKER_RX_STACK ( *( volatile unsigned int * ) 0xFE08 )
+
+/* Task storage */
+static StaticTask_t xRxTCB;
+static StackType_t  xRxStack[ configSTACK_DEPTH( xRxStack ) ];
+
+static StaticTask_t xBgTCB;
+static StackType_t  xBgStack[ configSTACK_DEPTH( xBgStack ) ];
+
+static StaticTask_t xIdleTaskTCB;
+static StackType_t  xIdleTaskStack[ configSTACK_DEPTH( xIdleTaskStack ) ];
+
+static TaskHandle_t xRxTask;
+
+/* Producer state (ISR only) */
+static volatile unsigned int uOffered;
+static unsigned char ucNextOut;
+
+#ifdef STREAM_QUEUE
+static StaticQueue_t xQueueBuffer;
+static uint8_t ucQueueStorage[ 128 ];
+static QueueHandle_t xQueue;
+#else
+RINGBUFFER_STORAGE( ucRingStorage, 128 );
+static RingBuffer_t xRing;
+#endif
+
+/*-----------------------------------------------------------
+ * Required by FreeRTOS static allocation
+ *-----------------------------------------------------------*/
+void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                    StackType_t ** ppxIdleTaskStackBuffer,
+                                    configSTACK_DEPTH_TYPE * pulIdleTaskStackSize )
+{
+    *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+    *ppxIdleTaskStackBuffer = xIdleTaskStack;
+    *pulIdleTaskStackSize = configSTACK_DEPTH( xIdleTaskStack );
+}
+
+/*-----------------------------------------------------------
+ * RST 5.5 handler (entered through PORT_ISR_NESTED, startup.S)
+ *-----------------------------------------------------------*/
+void vApplicationIRQHandler55( void )
+{
+    if( uOffered >= STREAM_BYTES )
+    {
+        return;
+    }
+
+    uOffered++;
+
+#ifdef STREAM_QUEUE
+    if( xQueueSendFromISR( xQueue, &ucNextOut, NULL ) != pdPASS )
+    {
+        MARKER_DROPPED++;
+    }
+#else
+    if( xRingBufferPutFromISR( &xRing, ucNextOut, NULL ) == pdFALSE )
+    {
+        MARKER_DROPPED++;
+    }
+#endif
+
+    ucNextOut++;
+}
+
+/*-----------------------------------------------------------
+ * Receiver: checks the sequence, resyncing after drops
+ *-----------------------------------------------------------*/
+static unsigned char ucExpected;
+
+static void prvCheck( unsigned char ucByte )
+{
+    if( ucByte != ucExpected )
+    {
+        /* Drops leave a gap; anything else is corruption */
+        if( MARKER_DROPPED == 0 )
+        {
+            MARKER_ERRORS++;
+        }
+    }
+
+    ucExpected = ( unsigned char ) ( ucByte + 1 );
+    MARKER_RX++;
+}
+
+static void prvFinishIfDone( void )
+{
+    if( ( uOffered >= STREAM_BYTES ) &&
+        ( MARKER_RX + MARKER_DROPPED >= STREAM_BYTES ) )
+    {
+        MARKER_RX_STACK = uxPortStackUnused( xRxStack, sizeof( xRxStack ) );
+
+        taskDISABLE_INTERRUPTS();
+
+        for( ;; )
+        {
+            __asm__ volatile ( "hlt" );
+        }
+    }
+}
+
+/* Interrupt masks are per task (the port restores each task's own SIM
+ * mask), so both tasks unmask RST 5.5 for themselves. */
+static void prvUnmaskRx( void )
+{
+    vPortRestoreMask( 0x0C );   /* MSE; 7.5 masked, 6.5 and 5.5 live */
+}
+
+static void vReceiver( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    prvUnmaskRx();
+
+    for( ;; )
+    {
+#ifdef STREAM_QUEUE
+        uint8_t ucByte;
+
+        if( xQueueReceive( xQueue, &ucByte, 1 ) == pdPASS )
+        {
+            prvCheck( ucByte );
+        }
+#else
+        uint8_t * pucSpan;
+        size_t xSpan, i;
+
+        if( xRingBufferWait( &xRing, 1 ) != pdFALSE )
+        {
+            /* Up to two spans per wakeup, parsed in place */
+            while( ( xSpan = xRingBufferGetSpan( &xRing, &pucSpan ) ) != 0 )
+            {
+                for( i = 0; i < xSpan; i++ )
+                {
+                    prvCheck( pucSpan[ i ] );
+                }
+
+                vRingBufferConsume( &xRing, xSpan );
+            }
+        }
+#endif
+        prvFinishIfDone();
+    }
+}
+
+/*-----------------------------------------------------------
+ * Background work
+ *-----------------------------------------------------------*/
+static void vBackground( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    prvUnmaskRx();
+
+    for( ;; )
+    {
+        MARKER_BG++;
+    }
+}
+
+/*-----------------------------------------------------------
+ * main
+ *-----------------------------------------------------------*/
+int main( void )
+{
+    MARKER_RX = 0;
+    MARKER_DROPPED = 0;
+    MARKER_ERRORS = 0;
+    MARKER_BG = 0;
+    MARKER_RX_STACK = 0;
+
+    xRxTask = xTaskCreateStatic( vReceiver, "Rx", configSTACK_DEPTH( xRxStack ),
+                                 NULL, 2, xRxStack, &xRxTCB );
+    xTaskCreateStatic( vBackground, "Bg", configSTACK_DEPTH( xBgStack ), NULL, 1,
+                       xBgStack, &xBgTCB );
+
+#ifdef STREAM_QUEUE
+    xQueue = xQueueCreateStatic( sizeof( ucQueueStorage ), 1, ucQueueStorage,
+                                 &xQueueBuffer );
+#else
+    vRingBufferInit( &xRing, ucRingStorage, sizeof( ucRingStorage ), xRxTask, 1 );
+#endif
+
+    /* Start scheduler - never returns */
+    vTaskStartScheduler();
+
+    for( ;; )
+    {
+    }
+}
@@ -0,0 +1,33 @@
+/*
+ * FreeRTOS Intel 8085 - compile-time checks for the port helpers
+ *
+ * The assembly helpers hard-code kernel types that only portmacro.h and
+ * the kernel headers define.  FreeRTOSConfig.h is included before those,
+ * so it cannot test them; this file does, and emits no code or data.
+ */
+
+#include <stddef.h>
+
+#include "FreeRTOS.h"
+#include "list.h"
+
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION
+/* port_prio.S: one bitmap bit per priority, in an 8- or 16-bit word. */
+_Static_assert( sizeof( UBaseType_t ) == 1 || sizeof( UBaseType_t ) == 2,
+                "port_prio.S handles an 8- or 16-bit UBaseType_t only" );
+_Static_assert( configMAX_PRIORITIES <= 8 * sizeof( UBaseType_t ),
+                "configMAX_PRIORITIES exceeds the bits in UBaseType_t" );
+#endif
+
+#if configUSE_PORT_OPTIMISED_LIST
+/* port_list.S: the offsets in its header comment, count returned in BC */
+_Static_assert( sizeof( UBaseType_t ) == 2,
+                "port_list.S expects a 16-bit UBaseType_t" );
+_Static_assert( offsetof( List_t, pxIndex ) == 2 &&
+                offsetof( List_t, xListEnd ) == 4,
+                "List_t layout does not match port_list.S" );
+_Static_assert( offsetof( ListItem_t, pxNext ) == 2 &&
+                offsetof( ListItem_t, pxPrevious ) == 4 &&
+                offsetof( ListItem_t, pxContainer ) == 8,
+                "ListItem_t layout does not match port_list.S" );
+#endif
@@ -0,0 +1,73 @@
+; ---------------------------------------------------------------------------
+; Intel 8085 FreeRTOS - interrupt priority levels and nested ISR entry
+;
+; Levels follow the 8085's fixed priorities (TRAP above all, not maskable):
+;
+;   1  RST 5.5      SIM mask bit 0
+;   2  RST 6.5      SIM mask bit 1  (kernel tick)
+;   3  RST 7.5      SIM mask bit 2
+;
+; configMAX_SYSCALL_INTERRUPT_PRIORITY (FreeRTOSConfig.h) splits them.
+; Lines at or below it may call FromISR APIs; ucPortRaiseMask() and
+; PORT_ISR_NESTED mask exactly those lines through SIM and leave the
+; ones above it (and TRAP) live.  Handlers above it must not call the
+; kernel.
+;
+; Include from .S files after FreeRTOSConfig.h.
+; ---------------------------------------------------------------------------
+
+#ifndef PORT_ISR_H
+#define PORT_ISR_H
+
+#define portIRQ_LEVEL_RST55     1
+#define portIRQ_LEVEL_RST65     2
+#define portIRQ_LEVEL_RST75     3
+
+/* SIM mask bits for every line at or below the syscall level */
+#define portSYSCALL_SIM_MASK    ( ( 1 << configMAX_SYSCALL_INTERRUPT_PRIORITY ) - 1 )
+
+; PORT_ISR_NESTED level, handler
+;
+; Vector body for a C handler (void handler(void)) that runs with
+; interrupts enabled.  Lines at or below max(level, syscall level) are
+; masked while it runs, so only higher lines nest and the tick (6.5)
+; never preempts a kernel-level handler -- a context switch from inside
+; a nested ISR would strand the rest of it.  A handler at or above 7.5
+; masks everything and simply runs with interrupts enabled for TRAP.
+; Runs on the interrupted task's stack: 12 bytes plus the handler's
+; frame per nesting level.
+.macro PORT_ISR_NESTED level, handler
+    PUSH PSW
+    PUSH B
+    PUSH D
+    PUSH H
+#if configUSE_TRACE_RECORDER
+    TRACE_ISR_ENTER \level
+#endif
+    RIM
+    ANI 0x07
+    ORI 0x08                ; interrupted mask, in SIM format
+    PUSH PSW
+.if \level > configMAX_SYSCALL_INTERRUPT_PRIORITY
+    ORI ( 1 << \level ) - 1
+.else
+    ORI portSYSCALL_SIM_MASK
+.endif
+    SIM
+    EI
+    CALL \handler
+    DI
+    POP PSW
+    SIM                     ; back to the interrupted mask
+#if configUSE_TRACE_RECORDER
+    TRACE_ISR_EXIT \level
+#endif
+    POP H
+    POP D
+    POP B
+    POP PSW
+    EI
+    RET
+.endm
+
+#endif /* PORT_ISR_H */
@@ -0,0 +1,46 @@
+/*
+ * FreeRTOS Intel 8085 - demo overrides of the port's portmacro.h
+ *
+ * The Makefile puts this directory ahead of portable/GCC/I8085, so the
+ * kernel, port.c and the demos include this file, which pulls in the
+ * port's own portmacro.h and then replaces what the demo options change.
+ *
+ * make MASK_CRITICAL=1 (configPORT_MASK_CRITICAL): kernel critical
+ * sections and portDISABLE_INTERRUPTS mask only the lines at or below
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY through SIM (port_mask.S) instead
+ * of DI, so RST 7.5 stays live inside them.  Sections nest per task, and
+ * portYIELD goes through vPortMaskYield to carry the count across a
+ * yield from inside a section.  The context switch and tick ISR still
+ * run with interrupts disabled.
+ */
+
+#ifndef DEMO_PORTMACRO_H
+#define DEMO_PORTMACRO_H
+
+#include_next "portmacro.h"
+
+#if configPORT_MASK_CRITICAL
+#ifndef __ASSEMBLER__
+extern volatile unsigned char ucPortCriticalNesting;
+extern void vPortMaskEnterCritical( void );
+extern void vPortMaskExitCritical( void );
+extern void vPortMaskDisableInterrupts( void );
+extern void vPortMaskEnableInterrupts( void );
+extern void vPortMaskYield( void );
+#endif
+
+#undef portENTER_CRITICAL
+#undef portEXIT_CRITICAL
+#undef portDISABLE_INTERRUPTS
+#undef portENABLE_INTERRUPTS
+#undef portYIELD
+#undef portYIELD_WITHIN_API      /* FreeRTOS.h defaults it to portYIELD */
+
+#define portENTER_CRITICAL()        vPortMaskEnterCritical()
+#define portEXIT_CRITICAL()         vPortMaskExitCritical()
+#define portDISABLE_INTERRUPTS()    vPortMaskDisableInterrupts()
+#define portENABLE_INTERRUPTS()     vPortMaskEnableInterrupts()
+#define portYIELD()                 vPortMaskYield()
+#endif
+
+#endif /* DEMO_PORTMACRO_H */
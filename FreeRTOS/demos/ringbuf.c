@@ -0,0 +1,129 @@
+/*
+ * FreeRTOS Intel 8085 - SPSC byte ring buffer, task side (see ringbuf.h)
+ */
+
+#include <string.h>
+
+#include "ringbuf.h"
+
+void vRingBufferInit( RingBuffer_t * pxRing,
+                      uint8_t * pucStorage,
+                      size_t xSize,
+                      TaskHandle_t xReceiver,
+                      uint8_t ucTriggerLevel )
+{
+    pxRing->ucHead = 0;
+    pxRing->ucTail = 0;
+    pxRing->ucMask = ( uint8_t ) ( xSize - 1 );
+    pxRing->ucWaiting = 0;
+    pxRing->pucBuffer = pucStorage;
+    pxRing->xReceiver = xReceiver;
+    pxRing->ucTrigger = ( ucTriggerLevel != 0 ) ? ucTriggerLevel : 1;
+    pxRing->usDropped = 0;
+}
+
+size_t xRingBufferBytesAvailable( const RingBuffer_t * pxRing )
+{
+    return ( uint8_t ) ( pxRing->ucHead - pxRing->ucTail ) & pxRing->ucMask;
+}
+
+size_t xRingBufferGetSpan( const RingBuffer_t * pxRing,
+                           uint8_t ** ppucData )
+{
+    uint8_t ucHead = pxRing->ucHead;
+    uint8_t ucTail = pxRing->ucTail;
+
+    *ppucData = pxRing->pucBuffer + ucTail;
+
+    if( ucHead >= ucTail )
+    {
+        return ( size_t ) ( ucHead - ucTail );
+    }
+
+    /* Wrapped: up to the end of the storage */
+    return ( size_t ) pxRing->ucMask + 1 - ucTail;
+}
+
+void vRingBufferConsume( RingBuffer_t * pxRing,
+                         size_t xCount )
+{
+    pxRing->ucTail = ( uint8_t ) ( pxRing->ucTail + xCount ) & pxRing->ucMask;
+}
+
+BaseType_t xRingBufferWait( RingBuffer_t * pxRing,
+                            TickType_t xTicksToWait )
+{
+    if( xRingBufferBytesAvailable( pxRing ) >= pxRing->ucTrigger )
+    {
+        return pdTRUE;
+    }
+
+    if( xTicksToWait != 0 )
+    {
+        /* Publish the flag before the re-check: a byte that lands in
+         * between either is seen here or sends the notification. */
+        pxRing->ucWaiting = 1;
+
+        if( xRingBufferBytesAvailable( pxRing ) < pxRing->ucTrigger )
+        {
+            ( void ) ulTaskNotifyTake( pdTRUE, xTicksToWait );
+        }
+
+        pxRing->ucWaiting = 0;
+
+        /* Drop a wake that raced the re-check */
+        ( void ) ulTaskNotifyTake( pdTRUE, 0 );
+    }
+
+    return ( xRingBufferBytesAvailable( pxRing ) != 0 ) ? pdTRUE : pdFALSE;
+}
+
+size_t xRingBufferReceive( RingBuffer_t * pxRing,
+                           void * pvRxData,
+                           size_t xBufferLengthBytes,
+                           TickType_t xTicksToWait )
+{
+    uint8_t * pucDest = ( uint8_t * ) pvRxData;
+    uint8_t * pucSpan;
+    size_t xSpan;
+    size_t xTotal = 0;
+
+    if( xRingBufferWait( pxRing, xTicksToWait ) == pdFALSE )
+    {
+        return 0;
+    }
+
+    /* At most two spans: up to the end of the storage, then from 0 */
+    while( xTotal < xBufferLengthBytes )
+    {
+        xSpan = xRingBufferGetSpan( pxRing, &pucSpan );
+
+        if( xSpan == 0 )
+        {
+            break;
+        }
+
+        if( xSpan > xBufferLengthBytes - xTotal )
+        {
+            xSpan = xBufferLengthBytes - xTotal;
+        }
+
+        memcpy( pucDest + xTotal, pucSpan, xSpan );
+        vRingBufferConsume( pxRing, xSpan );
+        xTotal += xSpan;
+    }
+
+    return xTotal;
+}
+
+BaseType_t xRingBufferWakeFromISR( RingBuffer_t * pxRing,
+                                   uint8_t ucByte,
+                                   BaseType_t * pxHigherPriorityTaskWoken )
+{
+    ( void ) ucByte;
+
+    pxRing->ucWaiting = 0;
+    vTaskNotifyGiveFromISR( pxRing->xReceiver, pxHigherPriorityTaskWoken );
+
+    return pdTRUE;
+}
@@ -0,0 +1,81 @@
+/*
+ * FreeRTOS Intel 8085 - single-producer/single-consumer byte ring buffer
+ *
+ * For ISR-to-task byte streams (UART, SID).  The ISR side appends one
+ * byte with xRingBufferPutFromISR() (ringbuf_isr.S): no critical
+ * section, no list or queue machinery, just an index compare, a store
+ * and a one-byte head update.  The task side reads in place: xRingBufferGetSpan() hands
+ * out the longest contiguous run of received bytes and
+ * vRingBufferConsume() releases it, so a parser never copies.  The
+ * stream-buffer style xRingBufferReceive() copies for callers that want
+ * it.
+ *
+ * Exactly one producer (one ISR, or one task) and one consumer task.
+ * The producer owns ucHead and the consumer ucTail; both are single
+ * bytes, so each side publishes its index with one store and no lock.
+ *
+ * Storage size is a power of two from 2 to 256 and must be aligned to
+ * its size (RINGBUFFER_STORAGE), so the index is ORed into the low
+ * address byte instead of added.  One slot stays empty: capacity is
+ * size - 1.
+ *
+ * The receiver blocks on its task notification (index 0), which the
+ * ring buffer owns: xRingBufferWait() clears stale notifications.
+ */
+
+#ifndef RINGBUF_H
+#define RINGBUF_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Layout is fixed: ringbuf_isr.S addresses the fields by offset. */
+typedef struct RingBuffer
+{
+    volatile uint8_t ucHead;        /* 0: next write index (producer) */
+    volatile uint8_t ucTail;        /* 1: next read index (consumer) */
+    uint8_t ucMask;                 /* 2: size - 1 */
+    volatile uint8_t ucWaiting;     /* 3: receiver blocked in xRingBufferWait */
+    uint8_t * pucBuffer;            /* 4: storage, aligned to its size */
+    TaskHandle_t xReceiver;         /* 6: task to notify */
+    uint8_t ucTrigger;              /* 8: wake the receiver at this many bytes */
+    volatile uint16_t usDropped;    /* 9: bytes lost to a full buffer */
+} RingBuffer_t;
+
+/* Storage for a ring of xSize bytes (power of two, <= 256) */
+#define RINGBUFFER_STORAGE( name, xSize ) \
+    static uint8_t name[ xSize ] __attribute__( ( aligned( xSize ) ) )
+
+void vRingBufferInit( RingBuffer_t * pxRing,
+                      uint8_t * pucStorage,
+                      size_t xSize,
+                      TaskHandle_t xReceiver,
+                      uint8_t ucTriggerLevel );
+
+/* Producer.  Returns pdFALSE (and counts the byte in usDropped) when
+ * full.  Wakes the receiver once ucTrigger bytes are waiting;
+ * pxHigherPriorityTaskWoken may be NULL. */
+BaseType_t xRingBufferPutFromISR( RingBuffer_t * pxRing,
+                                  uint8_t ucByte,
+                                  BaseType_t * pxHigherPriorityTaskWoken );
+
+/* Consumer */
+size_t xRingBufferBytesAvailable( const RingBuffer_t * pxRing );
+size_t xRingBufferGetSpan( const RingBuffer_t * pxRing,
+                           uint8_t ** ppucData );
+void vRingBufferConsume( RingBuffer_t * pxRing,
+                         size_t xCount );
+BaseType_t xRingBufferWait( RingBuffer_t * pxRing,
+                            TickType_t xTicksToWait );
+size_t xRingBufferReceive( RingBuffer_t * pxRing,
+                           void * pvRxData,
+                           size_t xBufferLengthBytes,
+                           TickType_t xTicksToWait );
+
+/* Wake path of xRingBufferPutFromISR (tail-called from ringbuf_isr.S
+ * with the same arguments); not for direct use. */
+BaseType_t xRingBufferWakeFromISR( RingBuffer_t * pxRing,
+                                   uint8_t ucByte,
+                                   BaseType_t * pxHigherPriorityTaskWoken );
+
+#endif /* RINGBUF_H */
@@ -0,0 +1,51 @@
+#!/usr/bin/env bash
+# ISR-to-task byte stream throughput (demo_stream.c)
+#
+# Runs the ring buffer (ringbuf.h) and queue builds with RST 5.5 firing
+# every P T-states for each P in PERIODS, and reports what reached the
+# receiver.  A period is sustained when nothing is dropped; "background"
+# is the low-priority loop count, i.e. CPU left over for the application.
+# 3200 T-states is 9600 baud at 3.072 MHz.
+#
+# Output: CSV (variant,period,received,dropped,errors,background,status)
+#
+# Usage: stream_bench.sh [period...]   (default 3200 1600 800 600 400 300)
+set -euo pipefail
+
+DEMOS="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+ROOT="$(cd "${DEMOS}/../.." && pwd)"
+TRACE="${TRACE:-$ROOT/i8085-trace/build/i8085-trace}"
+MAKE="${MAKE:-make}"
+
+PERIODS=("$@")
+if [[ ${#PERIODS[@]} -eq 0 ]]; then
+  PERIODS=(3200 1600 800 600 400 300)
+fi
+
+if [[ ! -x "${TRACE}" ]]; then
+  echo "Error: missing tool ${TRACE}" >&2
+  exit 1
+fi
+
+"${MAKE}" -s -C "${DEMOS}" stream streamq >&2
+
+echo "variant,period,received,dropped,errors,background,status"
+for variant in stream streamq; do
+  bin="${DEMOS}/build/freertos_${variant}.bin"
+  for p in "${PERIODS[@]}"; do
+    out="${DEMOS}/build/${variant}_${p}"
+    "${TRACE}" --timer=65:30720 --timer=55:"${p}" -n 50000000 -S -q \
+      -d 0xFE00:8 "${bin}" > "${out}.json" 2> "${out}.dump.txt" || true
+
+    halt="$(grep -o '"halt":"[^"]*"' "${out}.json" | cut -d'"' -f4)"
+    case "${halt}" in
+      hlt) status=HALTED ;;
+      max) status=TIMEOUT ;;
+      *) status="${halt:-UNKNOWN}" ;;
+    esac
+
+    # Markers are little-endian words at 0xFE00
+    read -r -a b <<< "$(sed -n 's/^ *[0-9A-Fa-f]\{4\}: *\([^|]*\).*/\1/p' "${out}.dump.txt" | tr '\n' ' ')"
+    echo "${variant/streamq/queue},${p},$((16#${b[1]}${b[0]})),$((16#${b[3]}${b[2]})),$((16#${b[5]}${b[4]})),$((16#${b[7]}${b[6]})),${status}"
+  done
+done
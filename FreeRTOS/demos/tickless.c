@@ -0,0 +1,77 @@
+/*
+ * FreeRTOS Intel 8085 - tickless idle (configUSE_TICKLESS_IDLE)
+ *
+ * The simulator's RST 6.5 timer (--timer=65:30720) is periodic and not
+ * reprogrammable, so the ticks cannot be stretched.  Instead they are
+ * made nearly free while idle: vPortSuppressTicksAndSleep() sets
+ * ucTicklessSleeping and halts, and the RST 6.5 vector (startup.S) then
+ * only counts the tick and returns to the HLT: 130 T-states from the
+ * vector's JMP to the RET (142 with the RST acknowledge cycle) instead
+ * of the full context save, xTaskIncrementTick() and restore.
+ * On wakeup the counted ticks are added back with vTaskStepTick().
+ *
+ * Sleep stops one tick short of the expected idle time, so the tick
+ * that unblocks a task goes through vPortTickISR as usual.  Wakeups
+ * therefore land on the same tick edge as without tickless idle (no
+ * added jitter) and the tick count never runs ahead of the kernel's
+ * next unblock time.  Any other interrupt ends the sleep early: after
+ * a HLT that was not a tick the loop exits and its pended work runs
+ * when the idle task resumes the scheduler.
+ *
+ * A board with a programmable timer (8155/8253) would reload it here
+ * for xExpectedIdleTime ticks instead and read back the elapsed count;
+ * the kernel-facing half of this file stays the same.
+ *
+ * Build: make TICKLESS=1 ...  (adds -DconfigUSE_TICKLESS_IDLE=1)
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if configUSE_TICKLESS_IDLE
+
+/* Shared with the RST 6.5 vector in startup.S */
+volatile unsigned char ucTicklessSleeping;
+volatile TickType_t xTicklessTicks;
+
+/* Declared in FreeRTOSConfig.h, ahead of TickType_t: the 16-bit tick
+ * type fits an unsigned int. */
+void vPortSuppressTicksAndSleep( unsigned int xExpectedIdleTime )
+{
+    TickType_t xSeen;
+
+    __asm__ volatile ( "di" );
+
+    /* A task readied (or a context switch pended) since the idle task
+     * decided to sleep: skip it. */
+    if( eTaskConfirmSleepModeStatus() == eAbortSleep )
+    {
+        __asm__ volatile ( "ei" );
+        return;
+    }
+
+    xTicklessTicks = 0;
+    ucTicklessSleeping = 1;
+
+    for( ;; )
+    {
+        xSeen = xTicklessTicks;
+
+        /* EI takes effect after the next instruction, so no interrupt
+         * can slip in between it and the HLT. */
+        __asm__ volatile ( "ei\n\thlt\n\tdi" ::: "memory" );
+
+        if( ( xTicklessTicks == xSeen ) ||
+            ( xTicklessTicks >= ( TickType_t ) ( xExpectedIdleTime - 1 ) ) )
+        {
+            break;
+        }
+    }
+
+    ucTicklessSleeping = 0;
+    vTaskStepTick( xTicklessTicks );
+
+    __asm__ volatile ( "ei" );
+}
+
+#endif /* configUSE_TICKLESS_IDLE */
@@ -0,0 +1,128 @@
+/*
+ * FreeRTOS Intel 8085 - trace recorder (make TRACE_RECORDER=1)
+ *
+ * Kernel trace hooks that write each event straight to two I/O ports:
+ * no RAM buffer, no timestamps on the target.  A simulator that logs
+ * every OUT with its cycle count provides the timeline, and
+ * tooling/freertos-trace.py turns that log into a Chrome trace /
+ * Perfetto timeline.  i8085-trace does not write such a log yet.
+ *
+ * An event is its code written to traceRECORDER_PORT, followed by its
+ * payload bytes written to traceRECORDER_PORT + 1:
+ *
+ *   code                          payload
+ *   0x01 TASK_CREATE              TCB (2, little-endian), name, 0
+ *   0x02 TASK_SWITCHED_IN         TCB (2)
+ *   0x03 QUEUE_CREATE             queue (2)
+ *   0x04 MUTEX_CREATE             queue (2)
+ *   0x05 QUEUE_SEND               queue (2)
+ *   0x06 QUEUE_SEND_FAILED        queue (2)
+ *   0x07 QUEUE_RECEIVE            queue (2)
+ *   0x08 QUEUE_RECEIVE_FAILED     queue (2)
+ *   0x09 BLOCKING_ON_QUEUE_SEND   queue (2)
+ *   0x0A BLOCKING_ON_QUEUE_RECEIVE queue (2)
+ *   0x0B QUEUE_SEND_FROM_ISR      queue (2)
+ *   0x0C QUEUE_RECEIVE_FROM_ISR   queue (2)
+ *   0x0D PRIORITY_INHERIT         TCB (2), new priority (1)
+ *   0x0E PRIORITY_DISINHERIT      TCB (2), original priority (1)
+ *   0x10 + level ISR_ENTER        none (level 1..3 = RST 5.5..7.5)
+ *   0x18 + level ISR_EXIT         none
+ *
+ * Events with a payload are emitted with interrupts disabled (masked
+ * up to the syscall level with MASK_CRITICAL=1) or from ISRs at or
+ * below that level, so the only thing that can land
+ * between a code and its payload is a higher ISR's payload-free enter
+ * or exit; the converter allows for that.
+ *
+ * Cost, hand-counted: ISR enter/exit is MVI + OUT (17 T-states) in the
+ * vector; the tick wrapper (startup.S) adds 106 T-states per tick; a
+ * kernel event with a 2-byte payload is 93 T-states in trace.S plus the
+ * call.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#ifndef traceRECORDER_PORT
+#define traceRECORDER_PORT              0xF0
+#endif
+#define traceRECORDER_DATA_PORT         ( traceRECORDER_PORT + 1 )
+
+#define traceEV_TASK_CREATE             0x01
+#define traceEV_TASK_SWITCHED_IN        0x02
+#define traceEV_QUEUE_CREATE            0x03
+#define traceEV_MUTEX_CREATE            0x04
+#define traceEV_QUEUE_SEND              0x05
+#define traceEV_QUEUE_SEND_FAILED       0x06
+#define traceEV_QUEUE_RECEIVE           0x07
+#define traceEV_QUEUE_RECEIVE_FAILED    0x08
+#define traceEV_BLOCKING_ON_SEND        0x09
+#define traceEV_BLOCKING_ON_RECEIVE     0x0A
+#define traceEV_QUEUE_SEND_FROM_ISR     0x0B
+#define traceEV_QUEUE_RECEIVE_FROM_ISR  0x0C
+#define traceEV_PRIORITY_INHERIT        0x0D
+#define traceEV_PRIORITY_DISINHERIT     0x0E
+#define traceEV_ISR_ENTER               0x10
+#define traceEV_ISR_EXIT                0x18
+
+#ifndef __ASSEMBLER__
+
+/* trace.S */
+extern void vTraceObject( unsigned char ucCode,
+                          const void * pvObject );
+extern void vTraceObjectValue( unsigned char ucCode,
+                               const void * pvObject,
+                               unsigned char ucValue );
+extern void vTraceTaskCreate( const void * pvTCB,
+                              const char * pcName );
+
+#define traceTASK_CREATE( pxNewTCB ) \
+    vTraceTaskCreate( ( pxNewTCB ), ( pxNewTCB )->pcTaskName )
+#define traceTASK_SWITCHED_IN() \
+    vTraceObject( traceEV_TASK_SWITCHED_IN, pxCurrentTCB )
+
+#define traceQUEUE_CREATE( pxNewQueue ) \
+    vTraceObject( traceEV_QUEUE_CREATE, ( pxNewQueue ) )
+#define traceCREATE_MUTEX( pxNewQueue ) \
+    vTraceObject( traceEV_MUTEX_CREATE, ( pxNewQueue ) )
+#define traceQUEUE_SEND( pxQueue ) \
+    vTraceObject( traceEV_QUEUE_SEND, ( pxQueue ) )
+#define traceQUEUE_SEND_FAILED( pxQueue ) \
+    vTraceObject( traceEV_QUEUE_SEND_FAILED, ( pxQueue ) )
+#define traceQUEUE_RECEIVE( pxQueue ) \
+    vTraceObject( traceEV_QUEUE_RECEIVE, ( pxQueue ) )
+#define traceQUEUE_RECEIVE_FAILED( pxQueue ) \
+    vTraceObject( traceEV_QUEUE_RECEIVE_FAILED, ( pxQueue ) )
+#define traceBLOCKING_ON_QUEUE_SEND( pxQueue ) \
+    vTraceObject( traceEV_BLOCKING_ON_SEND, ( pxQueue ) )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue ) \
+    vTraceObject( traceEV_BLOCKING_ON_RECEIVE, ( pxQueue ) )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue ) \
+    vTraceObject( traceEV_QUEUE_SEND_FROM_ISR, ( pxQueue ) )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue ) \
+    vTraceObject( traceEV_QUEUE_RECEIVE_FROM_ISR, ( pxQueue ) )
+
+#define traceTASK_PRIORITY_INHERIT( pxTCBOfMutexHolder, uxInheritedPriority ) \
+    vTraceObjectValue( traceEV_PRIORITY_INHERIT, ( pxTCBOfMutexHolder ),      \
+                       ( unsigned char ) ( uxInheritedPriority ) )
+#define traceTASK_PRIORITY_DISINHERIT( pxTCBOfMutexHolder, uxOriginalPriority ) \
+    vTraceObjectValue( traceEV_PRIORITY_DISINHERIT, ( pxTCBOfMutexHolder ),     \
+                       ( unsigned char ) ( uxOriginalPriority ) )
+
+#else /* __ASSEMBLER__ */
+
+; TRACE_ISR_ENTER level / TRACE_ISR_EXIT level: one payload-free event,
+; clobbers A
+.macro TRACE_ISR_ENTER level
+    MVI A, traceEV_ISR_ENTER + \level
+    OUT traceRECORDER_PORT
+.endm
+
+.macro TRACE_ISR_EXIT level
+    MVI A, traceEV_ISR_EXIT + \level
+    OUT traceRECORDER_PORT
+.endm
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* TRACE_H */
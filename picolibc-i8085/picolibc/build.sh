@@ -13,11 +13,26 @@ if [[ ! -d "$SRC_DIR" ]]; then
   exit 1
 fi
 
+# Local changes to the picolibc sources (patches/*.patch), applied once.
+for patch in "$ROOT"/picolibc-i8085/picolibc/patches/*.patch; do
+  [[ -e "$patch" ]] || continue
+  if git -C "$SRC_DIR" apply --reverse --check "$patch" 2>/dev/null; then
+    continue
+  fi
+  echo "Applying $(basename "$patch")"
+  git -C "$SRC_DIR" apply "$patch"
+done
+
 if [[ ! -x "$TOOLCHAIN_BIN/clang" ]]; then
   echo "Toolchain not found at $TOOLCHAIN_BIN" >&2
   exit 1
 fi
 
+# stdio: plain printf/scanf are the integer-only variant, since the double
+# variant pulls in the Ryu tables (~78KB).  The float variant (__f_vfprintf,
+# -DPICOLIBC_FLOAT_PRINTF_SCANF) formats binary32 with the small
+# non-exact engine instead of Ryu.  See BUILDING.md for link-time selection.
+
 # Generate cross file from template with resolved paths
 CROSS_FILE="$BUILD_DIR/i8085-unknown-elf.txt"
 mkdir -p "$BUILD_DIR"
@@ -36,6 +51,8 @@ meson setup "$BUILD_DIR" "$SRC_DIR" \
   -Dpicocrt-lib=false \
   -Dthread-local-storage=false \
   -Dnewlib-global-errno=true \
+  -Dformat-default=integer \
+  -Dio-float-exact=false \
   -Dspecsdir=none
 
 ninja -C "$BUILD_DIR"
@@ -0,0 +1,54 @@
+/*
+ * i8085 CRC and checksum kernels (builtins/crc.S, linked from libgcc.a).
+ *
+ * Each CRC comes in three variants:
+ *   _tab  256-entry table, fastest (256/512/1024 bytes of table)
+ *   _nib  16-entry table (16/32/64 bytes of table)
+ *   _bit  bitwise, no table
+ * The unsuffixed names are the variant picked when libgcc is built
+ * (build-libgcc.sh --crc=tab|nib|bit, default nib).
+ *
+ * All functions take the running value and return the updated one, so a
+ * buffer can be processed in pieces:
+ *   crc8         poly 0x07, MSB first; start from 0 (CRC-8/SMBUS)
+ *   crc16_ccitt  poly 0x1021, MSB first; start from 0xFFFF
+ *                (CRC-16/CCITT-FALSE) or 0 (XMODEM)
+ *   crc32        zlib's crc32(): start from 0, crc32(0, "123456789", 9)
+ *                == 0xCBF43926
+ *   fletcher16   sum1 in the low byte, sum2 in the high byte; start from 0
+ *   adler32      zlib's adler32(); start from 1
+ */
+
+#ifndef _I8085_CRC_H
+#define _I8085_CRC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint8_t crc8(uint8_t crc, const void *buf, size_t len);
+uint8_t crc8_tab(uint8_t crc, const void *buf, size_t len);
+uint8_t crc8_nib(uint8_t crc, const void *buf, size_t len);
+uint8_t crc8_bit(uint8_t crc, const void *buf, size_t len);
+
+uint16_t crc16_ccitt(uint16_t crc, const void *buf, size_t len);
+uint16_t crc16_ccitt_tab(uint16_t crc, const void *buf, size_t len);
+uint16_t crc16_ccitt_nib(uint16_t crc, const void *buf, size_t len);
+uint16_t crc16_ccitt_bit(uint16_t crc, const void *buf, size_t len);
+
+uint32_t crc32(uint32_t crc, const void *buf, size_t len);
+uint32_t crc32_tab(uint32_t crc, const void *buf, size_t len);
+uint32_t crc32_nib(uint32_t crc, const void *buf, size_t len);
+uint32_t crc32_bit(uint32_t crc, const void *buf, size_t len);
+
+uint16_t fletcher16(uint16_t sum, const void *buf, size_t len);
+uint32_t adler32(uint32_t adler, const void *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _I8085_CRC_H */
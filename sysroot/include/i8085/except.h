@@ -0,0 +1,101 @@
+/*
+ * i8085 setjmp/longjmp exceptions (builtins/setjmp.S, linked from
+ * libgcc.a).
+ *
+ * C++ here is built with -fno-exceptions: DWARF unwind tables and a
+ * personality routine would not fit the ROM budget.  This is the SJLJ
+ * alternative.  Each try block links an exc_frame_t (6 bytes, on the
+ * stack) into the __exc_top chain; that chain is the only table.  A
+ * throw unlinks the innermost frame and longjmps to it.
+ *
+ * Cost: the non-throwing path pays one setjmp() and two stores of
+ * __exc_top per try block (about 200 cycles).  Calls between the try
+ * and the throw cost nothing.  A throw costs about 250 cycles plus the
+ * handler, however deep the call stack.
+ *
+ * Like longjmp(), a throw does not run destructors of the frames it
+ * skips, and locals of the function containing the try block that
+ * change inside it must be volatile to be read in the handler.  Keep
+ * heap ownership outside the try body, or release it in the handler.
+ *
+ *   C:
+ *     EXC_TRY {
+ *         parse(buf);             // may call exc_throw(code)
+ *     } EXC_CATCH(code) {
+ *         report(code);
+ *     } EXC_END
+ *   Leave the EXC_TRY body only by falling off its end: return, break
+ *   or goto out of it leave the frame linked.
+ *
+ *   C++:
+ *     i8085::exc_try([&] { parse(buf); },
+ *                    [&](int code) { report(code); });
+ *
+ * Codes are nonzero ints (exc_throw(0) throws 1).  Throwing with no try
+ * block active calls abort().
+ */
+
+#ifndef _I8085_EXCEPT_H
+#define _I8085_EXCEPT_H
+
+#include <setjmp.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct exc_frame {
+    jmp_buf env;                /* resume point: PC, SP */
+    struct exc_frame *prev;     /* enclosing try block */
+} exc_frame_t;
+
+/* Innermost active try frame, 0 when none. */
+extern exc_frame_t *__exc_top;
+
+/* Throw code to the innermost try block. */
+void exc_throw(int code) __attribute__((__noreturn__));
+
+#define EXC_TRY                                                        \
+    {                                                                  \
+        exc_frame_t __exc_f;                                           \
+        int __exc_code;                                                \
+        __exc_f.prev = __exc_top;                                      \
+        __exc_top = &__exc_f;                                          \
+        if ((__exc_code = setjmp(__exc_f.env)) == 0)
+
+#define EXC_CATCH(e)                                                   \
+        if (__exc_code == 0)                                           \
+            __exc_top = __exc_f.prev;                                  \
+        else {                                                         \
+            int e = __exc_code;
+
+#define EXC_END                                                        \
+        }                                                              \
+    }
+
+#ifdef __cplusplus
+}
+
+namespace i8085 {
+
+/* Run body(); if it throws, run handler(code) instead of returning
+   normally.  The frame lives in this function, so it is always
+   unlinked, whichever way body() returns. */
+template <typename Body, typename Handler>
+inline void exc_try(Body &&body, Handler &&handler) {
+    exc_frame_t f;
+    f.prev = __exc_top;
+    __exc_top = &f;
+    int code = setjmp(f.env);
+    if (code == 0) {
+        body();
+        __exc_top = f.prev;
+    } else {
+        handler(code);
+    }
+}
+
+} // namespace i8085
+#endif
+
+#endif /* _I8085_EXCEPT_H */
@@ -0,0 +1,68 @@
+/*
+ * i8085 fixed-point helpers (builtins/fixmath.S, linked from libgcc.a).
+ *
+ * Plain-integer view of the Q7 / Q15 / Q8.8 / Q16.16 runtime, for code
+ * that does not use the TR 18037 _Fract/_Accum types.  All operations
+ * saturate; multiply rounds half up, divide rounds half away from zero.
+ *
+ * Q7 and Q15 use libgcc's short _Fract / _Fract names.  Q8.8 and Q16.16
+ * are not libgcc's short _Accum / _Accum (s8.7 / s16.15) and have
+ * __i8085_ names of their own.
+ */
+
+#ifndef _I8085_FIXMATH_H
+#define _I8085_FIXMATH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int8_t  q7_t;     /* s.7    short _Fract */
+typedef int16_t q15_t;    /* s.15   _Fract */
+typedef int16_t q8_8_t;   /* s7.8 */
+typedef int32_t q16_16_t; /* s15.16 */
+
+int8_t  __ssaddqq3(int8_t, int8_t);
+int8_t  __sssubqq3(int8_t, int8_t);
+int8_t  __ssmulqq3(int8_t, int8_t);
+int8_t  __ssdivqq3(int8_t, int8_t);
+int16_t __ssaddhq3(int16_t, int16_t);
+int16_t __sssubhq3(int16_t, int16_t);
+int16_t __ssmulhq3(int16_t, int16_t);
+int16_t __ssdivhq3(int16_t, int16_t);
+int16_t __i8085_ssaddq8_8(int16_t, int16_t);
+int16_t __i8085_sssubq8_8(int16_t, int16_t);
+int16_t __i8085_ssmulq8_8(int16_t, int16_t);
+int16_t __i8085_ssdivq8_8(int16_t, int16_t);
+int32_t __i8085_ssaddq16_16(int32_t, int32_t);
+int32_t __i8085_sssubq16_16(int32_t, int32_t);
+int32_t __i8085_ssmulq16_16(int32_t, int32_t);
+int32_t __i8085_ssdivq16_16(int32_t, int32_t);
+
+static inline q7_t q7_add(q7_t a, q7_t b) { return __ssaddqq3(a, b); }
+static inline q7_t q7_sub(q7_t a, q7_t b) { return __sssubqq3(a, b); }
+static inline q7_t q7_mul(q7_t a, q7_t b) { return __ssmulqq3(a, b); }
+static inline q7_t q7_div(q7_t a, q7_t b) { return __ssdivqq3(a, b); }
+
+static inline q15_t q15_add(q15_t a, q15_t b) { return __ssaddhq3(a, b); }
+static inline q15_t q15_sub(q15_t a, q15_t b) { return __sssubhq3(a, b); }
+static inline q15_t q15_mul(q15_t a, q15_t b) { return __ssmulhq3(a, b); }
+static inline q15_t q15_div(q15_t a, q15_t b) { return __ssdivhq3(a, b); }
+
+static inline q8_8_t q8_8_add(q8_8_t a, q8_8_t b) { return __i8085_ssaddq8_8(a, b); }
+static inline q8_8_t q8_8_sub(q8_8_t a, q8_8_t b) { return __i8085_sssubq8_8(a, b); }
+static inline q8_8_t q8_8_mul(q8_8_t a, q8_8_t b) { return __i8085_ssmulq8_8(a, b); }
+static inline q8_8_t q8_8_div(q8_8_t a, q8_8_t b) { return __i8085_ssdivq8_8(a, b); }
+
+static inline q16_16_t q16_16_add(q16_16_t a, q16_16_t b) { return __i8085_ssaddq16_16(a, b); }
+static inline q16_16_t q16_16_sub(q16_16_t a, q16_16_t b) { return __i8085_sssubq16_16(a, b); }
+static inline q16_16_t q16_16_mul(q16_16_t a, q16_16_t b) { return __i8085_ssmulq16_16(a, b); }
+static inline q16_16_t q16_16_div(q16_16_t a, q16_16_t b) { return __i8085_ssdivq16_16(a, b); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _I8085_FIXMATH_H */
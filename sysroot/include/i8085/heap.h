@@ -0,0 +1,34 @@
+/*
+ * i8085 heap allocator extras (builtins/malloc.S, linked from libgcc.a).
+ *
+ * malloc/free/calloc/realloc, malloc_usable_size and mallinfo are
+ * declared in <malloc.h>.  mallinfo fields follow newlib's meaning,
+ * except that smblks/fsmblks count the blocks cached in the small-size
+ * bins and keepcost is the never-used space above the heap top.
+ */
+
+#ifndef _I8085_HEAP_H
+#define _I8085_HEAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Largest block size (header included) served from the small bins. */
+#define MALLOC_SMALL_MAX 32
+
+/* malloc_check() results */
+#define MALLOC_CHECK_OK    0
+#define MALLOC_CHECK_CHAIN 1 /* block sizes do not chain up to the top */
+#define MALLOC_CHECK_ORDER 2 /* free list unordered or outside the heap */
+#define MALLOC_CHECK_FREE  3 /* free list disagrees with the block chain */
+#define MALLOC_CHECK_BIN   4 /* corrupt small-bin entry */
+
+/* Walk the whole heap and check its invariants.  O(heap blocks). */
+int malloc_check(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _I8085_HEAP_H */
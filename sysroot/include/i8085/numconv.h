@@ -0,0 +1,33 @@
+/*
+ * i8085 integer <-> decimal conversion (builtins/numconv.S, linked from
+ * libgcc.a).
+ *
+ * utoa/itoa are declared in <stdlib.h>; the base-10 path of all four
+ * *toa functions converts through packed BCD (DAA) instead of dividing
+ * by 10 per digit.  Other bases 2..36 use lowercase digits; a base
+ * outside that range stores an empty string and returns NULL.  Only
+ * base 10 prints a '-' sign, as in newlib.
+ *
+ * Buffer sizes, terminator included: 7 bytes (int), 12 bytes (long),
+ * 33 bytes (long, base 2).
+ */
+
+#ifndef _I8085_NUMCONV_H
+#define _I8085_NUMCONV_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+char *ultoa(unsigned long value, char *str, int base);
+char *ltoa(long value, char *str, int base);
+
+/* tinystdio's base-10 digit generator: writes the digits of value
+ * least significant first, without a terminator, and returns the end. */
+char *__ultoa_invert10(unsigned long value, char *str);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _I8085_NUMCONV_H */
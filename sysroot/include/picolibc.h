@@ -57,9 +57,9 @@
 #define __IO_C99_FORMATS
 
 /* The default printf and scanf variants */
-#define __IO_DEFAULT 'd'
+#define __IO_DEFAULT 'i'
 
-#define __IO_FLOAT_EXACT
+#undef __IO_FLOAT_EXACT
 
 #undef __IO_LONG_DOUBLE
 
@@ -5,11 +5,17 @@ ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
 TOOLBIN="${TOOLBIN:-$ROOT/llvm-project/build-clang-8085/bin}"
 SYSROOT="${SYSROOT:-$ROOT/sysroot}"
 
-# Parse --undoc flag
+# Parse --undoc, --crc=tab|nib|bit and --bitops=tab|nib flags
 UNDOC=0
+CRC_VARIANT=nib
+BITOPS_VARIANT=nib
 for arg in "$@"; do
   if [[ "$arg" == "--undoc" ]]; then
     UNDOC=1
+  elif [[ "$arg" == --crc=* ]]; then
+    CRC_VARIANT="${arg#--crc=}"
+  elif [[ "$arg" == --bitops=* ]]; then
+    BITOPS_VARIANT="${arg#--bitops=}"
   fi
 done
 
@@ -28,6 +34,23 @@ if [[ "${UNDOC}" -eq 1 ]]; then
   echo "Building with undocumented 8085 instruction support"
 fi
 
+# Which variant the unsuffixed crc8/crc16_ccitt/crc32 names bind to:
+# 256-entry tables (fast, up to 1 KB ROM), 16-entry tables, or bitwise.
+case "${CRC_VARIANT}" in
+  tab) CRC_FLAGS="-DCRC_FAST" ;;
+  nib) CRC_FLAGS="" ;;
+  bit) CRC_FLAGS="-DCRC_SMALL" ;;
+  *) echo "unknown --crc variant: ${CRC_VARIANT} (tab, nib or bit)" >&2; exit 1 ;;
+esac
+
+# Per-byte clz/ctz/popcount kernel: 256-entry tables (256 bytes ROM each) or
+# nibble tables / SWAR.
+case "${BITOPS_VARIANT}" in
+  tab) BITOPS_FLAGS="-DBITOPS_FAST" ;;
+  nib) BITOPS_FLAGS="" ;;
+  *) echo "unknown --bitops variant: ${BITOPS_VARIANT} (tab or nib)" >&2; exit 1 ;;
+esac
+
 if [[ ! -x "${CLANG}" || ! -x "${LLC}" || ! -x "${AR}" ]]; then
   echo "missing toolchain in ${TOOLBIN}" >&2
   exit 1
@@ -156,18 +179,31 @@ fi
 # addsf3, subsf3, negsf2, mulsf3, divsf3, comparesf2, fixsfsi, fixunssfsi,
 # floatsisf, floatunsisf, fe_getround, fe_raise_inexact
 
+# Single-precision libm core (sqrtf, sinf, cosf, atan2f, expf, logf) is
+# hand-written in mathf.S; it precedes libc.a on the link line, so it
+# replaces picolibc's versions of these functions.
+
+# Fixed-point runtime (Q7/Q15/Q8.8/Q16.16 saturating add/sub/mul/div;
+# libgcc fixed-bit names for Q7/Q15) is hand-written in fixmath.S.
+
 # Hand-written assembly helpers: memory operations, integer multiply,
 # integer division, 64-bit shifts, and 64-bit add/sub.
 # Assembly avoids bootstrapping issues and gives much better performance
 # than the C versions compiled through the i8085 backend.
-for helper in memops int_mul int_div int_shift int_shift64 int_arith64 int_divdi3 ctzsi2 ctzdi2 clzdi2 popcountsi2 int_rotate int_rotate64 int_fshl stringops softfp malloc; do
+for helper in memops int_mul int_div int_shift int_shift64 int_arith64 int_divdi3 ctzsi2 ctzdi2 clzdi2 popcountsi2 bitops int_rotate int_rotate64 int_fshl stringops numconv frame crc setjmp softfp mathf fixmath malloc; do
   src="${LIBI8085_BUILTINS_DIR}/${helper}.S"
   if [[ ! -f "${src}" ]]; then
     echo "missing source: ${src}" >&2
     exit 1
   fi
+  flags="${ASM_UNDOC_FLAGS}"
+  if [[ "${helper}" == "crc" ]]; then
+    flags="${flags} ${CRC_FLAGS}"
+  elif [[ "${helper}" == "bitops" ]]; then
+    flags="${flags} ${BITOPS_FLAGS}"
+  fi
   # shellcheck disable=SC2086
-  "${CLANG}" -target i8085-unknown-elf ${ASM_UNDOC_FLAGS} -c "${src}" -o "${OUT_DIR}/${helper}.o"
+  "${CLANG}" -target i8085-unknown-elf ${flags} -c "${src}" -o "${OUT_DIR}/${helper}.o"
 done
 
 for helper in floatdisf floatundisf; do
@@ -0,0 +1,178 @@
+/*
+ * Heap allocation churn benchmark for i8085.
+ *
+ * Keeps SLOTS live blocks and, for ROUNDS iterations, frees a
+ * pseudo-randomly chosen slot and reallocates it with a new size drawn
+ * from an embedded-style mix: 70% small (2..24 bytes), 25% medium
+ * (25..128), 5% large (129..256).  Every block is filled with a pattern
+ * that is checked before the block is freed.
+ *
+ * Default build links builtins/malloc.S from libgcc.a.  Built with
+ * -DALLOC_HEAP4 (FreeRTOS/demos: make churn) the same sequence runs on
+ * FreeRTOS heap_4 (pvPortMalloc/vPortFree, before the scheduler starts)
+ * so both allocators can be compared for cycles and fragmentation.
+ *
+ * Output at OUTPUT_ADDR (16-bit words):
+ *   +0 pass (1 = no corruption, heap consistent)
+ *   +2 failed allocations
+ *   +4 peak live payload bytes
+ *   +6 peak heap footprint (bytes the allocator had to take)
+ *   +8 largest block allocatable after the churn with every other slot
+ *      still live, capped at PROBE_MAX (fragmentation)
+ * OUTPUT_ADDR lies inside the malloc heap under the default linker
+ * script, so the results are written only once every block is freed
+ * and the heap has been checked.  Halts on success.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef ALLOC_HEAP4
+#include "FreeRTOS.h"
+#include "task.h"
+#define ALLOC(n) pvPortMalloc(n)
+#define FREE(p)  vPortFree(p)
+#else
+#include <stdlib.h>
+#include <i8085/heap.h>
+#define ALLOC(n) malloc(n)
+#define FREE(p)  free(p)
+extern uint8_t *__malloc_heap_ptr;
+extern uint8_t __heap_start[];
+#endif
+
+#ifndef OUTPUT_ADDR
+#define OUTPUT_ADDR 0x0200 /* the FreeRTOS build uses its 0xFE00 markers */
+#endif
+#define SLOTS 32
+#define ROUNDS 2000
+#define PROBE_MAX 4096
+
+__attribute__((noinline)) static void halt_ok(void) { __asm__ volatile("hlt"); }
+__attribute__((noinline)) static void fail_loop(void) { for (;;) {} }
+
+static uint8_t *slot_ptr[SLOTS];
+static uint16_t slot_len[SLOTS];
+static uint8_t slot_pat[SLOTS];
+
+static uint16_t rng = 0xACE1;
+static uint16_t live_bytes, peak_live, peak_foot, failures;
+static uint8_t corrupt;
+
+static uint16_t next_rand(void) {
+    /* 16-bit Galois LFSR, taps 0xB400 */
+    uint16_t lsb = rng & 1;
+    rng >>= 1;
+    if (lsb) rng ^= 0xB400;
+    return rng;
+}
+
+static uint16_t pick_size(void) {
+    uint16_t r = next_rand() % 100;
+    uint16_t v = next_rand();
+    if (r < 70) return 2 + v % 23;
+    if (r < 95) return 25 + v % 104;
+    return 129 + v % 128;
+}
+
+#ifdef ALLOC_HEAP4
+/* tasks.c wants this even though the scheduler never starts. */
+static StaticTask_t idle_tcb;
+static StackType_t idle_stack[configMINIMAL_STACK_SIZE];
+
+void vApplicationGetIdleTaskMemory(StaticTask_t **tcb, StackType_t **stack,
+                                   configSTACK_DEPTH_TYPE *depth) {
+    *tcb = &idle_tcb;
+    *stack = idle_stack;
+    *depth = configMINIMAL_STACK_SIZE;
+}
+#endif
+
+/* High-water mark of the heap area the allocator has touched. */
+static uint16_t footprint(void) {
+#ifdef ALLOC_HEAP4
+    return configTOTAL_HEAP_SIZE - xPortGetMinimumEverFreeHeapSize();
+#else
+    uint16_t top = (uint16_t)(__malloc_heap_ptr - __heap_start);
+    if (top < peak_foot) top = peak_foot;
+    return top;
+#endif
+}
+
+static void slot_free(uint8_t i) {
+    uint8_t *p = slot_ptr[i];
+    uint16_t n = slot_len[i];
+    uint8_t pat = slot_pat[i];
+    uint16_t k;
+    if (!p) return;
+    for (k = 0; k < n; k++)
+        if (p[k] != pat) corrupt = 1;
+    FREE(p);
+    slot_ptr[i] = NULL;
+    live_bytes -= n;
+}
+
+static void slot_alloc(uint8_t i, uint16_t n) {
+    uint8_t *p = ALLOC(n);
+    uint8_t pat = (uint8_t)(next_rand() | 1);
+    uint16_t k;
+    if (!p) {
+        failures++;
+        return;
+    }
+    for (k = 0; k < n; k++) p[k] = pat;
+    slot_ptr[i] = p;
+    slot_len[i] = n;
+    slot_pat[i] = pat;
+    live_bytes += n;
+    if (live_bytes > peak_live) peak_live = live_bytes;
+    peak_foot = footprint();
+}
+
+/* Largest size that can be allocated right now (binary search). */
+static uint16_t largest_block(void) {
+    uint16_t lo = 0, hi = PROBE_MAX;
+    while (lo < hi) {
+        uint16_t mid = lo + (hi - lo + 1) / 2;
+        void *p = ALLOC(mid);
+        if (p) {
+            FREE(p);
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return lo;
+}
+
+int main(void) {
+    volatile uint16_t *output = (volatile uint16_t *)OUTPUT_ADDR;
+    uint16_t round, largest;
+    uint8_t i;
+
+    for (i = 0; i < SLOTS; i++) slot_alloc(i, pick_size());
+
+    for (round = 0; round < ROUNDS; round++) {
+        i = next_rand() % SLOTS;
+        slot_free(i);
+        slot_alloc(i, pick_size());
+    }
+
+    for (i = 0; i < SLOTS; i += 2) slot_free(i);
+    largest = largest_block();
+    for (i = 1; i < SLOTS; i += 2) slot_free(i);
+
+#ifndef ALLOC_HEAP4
+    if (malloc_check() != MALLOC_CHECK_OK) corrupt = 1;
+#endif
+
+    output[1] = failures;
+    output[2] = peak_live;
+    output[3] = peak_foot;
+    output[4] = largest;
+    output[0] = !corrupt;
+
+    if (!corrupt) halt_ok();
+    fail_loop();
+    return 0;
+}
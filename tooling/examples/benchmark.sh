@@ -40,7 +40,7 @@ done
 # Benchmarks to run (can be overridden via args)
 BENCHMARKS=("$@")
 if [[ ${#BENCHMARKS[@]} -eq 0 ]]; then
-  BENCHMARKS=(fib q7_8_matmul opt_sanity deep_recursion crc32 crc32_lut bubble_sort json_parse mul_torture div_torture bitops_torture string_torture float_torture fp_bench arith64_torture)
+  BENCHMARKS=(fib q7_8_matmul opt_sanity deep_recursion crc32 crc32_lut bubble_sort json_parse mul_torture div_torture bitops_torture string_torture float_torture fp_bench mathf_bench alloc_churn printf_bench arith64_torture crc_bench)
 fi
 
 # Optimization levels to test
@@ -94,9 +94,21 @@ MAX_STEPS[float_torture]="5000000"
 DUMP_RANGE[fp_bench]="0x0200:12"
 MAX_STEPS[fp_bench]="5000000"
 
+DUMP_RANGE[mathf_bench]="0x0200:9"
+MAX_STEPS[mathf_bench]="20000000"
+
+DUMP_RANGE[alloc_churn]="0x0200:10"
+MAX_STEPS[alloc_churn]="20000000"
+
+DUMP_RANGE[printf_bench]="0x0200:6"
+MAX_STEPS[printf_bench]="20000000"
+
 DUMP_RANGE[arith64_torture]="0x0200:4"
 MAX_STEPS[arith64_torture]="50000000"
 
+DUMP_RANGE[crc_bench]="0x0200:6"
+MAX_STEPS[crc_bench]="20000000"
+
 DUMP_RANGE[coremark]="0x0200:4"
 MAX_STEPS[coremark]="100000000"
 
@@ -115,7 +127,11 @@ LINKER_SCRIPT[bitops_torture]="${LINKER_LARGE}"
 LINKER_SCRIPT[string_torture]="${LINKER_INPUT}"
 LINKER_SCRIPT[float_torture]="${LINKER_DEFAULT}"
 LINKER_SCRIPT[fp_bench]="${LINKER_DEFAULT}"
+LINKER_SCRIPT[mathf_bench]="${LINKER_DEFAULT}"
+LINKER_SCRIPT[alloc_churn]="${LINKER_DEFAULT}"
+LINKER_SCRIPT[printf_bench]="${LINKER_LARGE}"
 LINKER_SCRIPT[arith64_torture]="${LINKER_LARGE}"
+LINKER_SCRIPT[crc_bench]="${LINKER_LARGE}"
 LINKER_SCRIPT[coremark]="${LINKER_LARGE}"
 
 # Expected output files
@@ -133,7 +149,11 @@ EXPECTED_FILE[bitops_torture]=""
 EXPECTED_FILE[string_torture]=""
 EXPECTED_FILE[float_torture]=""
 EXPECTED_FILE[fp_bench]=""
+EXPECTED_FILE[mathf_bench]=""
+EXPECTED_FILE[alloc_churn]=""
+EXPECTED_FILE[printf_bench]=""
 EXPECTED_FILE[arith64_torture]=""
+EXPECTED_FILE[crc_bench]=""
 EXPECTED_FILE[coremark]=""
 
 # Output format
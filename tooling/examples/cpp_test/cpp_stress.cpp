@@ -1,13 +1,15 @@
 // C++ codegen stress test for i8085 backend
 // Tests: lambdas with captures, multiple inheritance, move semantics,
 //        variadic templates, structured bindings, std::function,
-//        deep inheritance chains.
+//        deep inheritance chains, error propagation.
 //
 // Build: clang++ --target=i8085-unknown-elf -ffreestanding -fno-builtin
 //   -fno-exceptions -fno-rtti -fno-threadsafe-statics -nostdinc++
 //   -isystem $SYSROOT/include/c++/v1 -isystem $SYSROOT/include -std=c++17
+// Add -DERR_SJLJ to propagate section 9's errors with <i8085/except.h>
+// instead of status codes (except_bench.sh compares the two).
 //
-// Expected output at 0xE000 (40 bytes):
+// Expected output at 0xE000 (44 bytes):
 //   See byte layout below.
 
 #include <stdint.h>
@@ -18,6 +20,10 @@
 #include <tuple>
 #include <initializer_list>
 
+#ifdef ERR_SJLJ
+#include <i8085/except.h>
+#endif
+
 // C++ runtime stubs for freestanding environment
 extern "C" void *malloc(size_t);
 extern "C" void free(void *);
@@ -350,6 +356,107 @@ static void test_lambda_comparator() {
     emit(arr[4]);  // [37] = 10 (0x0A) — smallest last
 }
 
+// =========================================================================
+// 9. Error propagation: status codes vs SJLJ exceptions
+// =========================================================================
+
+// Three-level record decoder.  By default every level returns a status
+// code that its caller checks; with ERR_SJLJ the failing level throws
+// and only the loop in test_error_propagation() has a handler.
+
+enum : uint8_t { ERR_NONE = 0, ERR_RANGE = 1, ERR_CHECK = 2 };
+
+struct Record {
+    uint8_t len;
+    uint8_t data[4];
+    uint8_t sum;
+};
+
+static const Record records[] = {
+    {3, {10, 20, 30, 0}, 60},
+    {4, {1, 2, 3, 4}, 10},
+    {2, {200, 5, 0, 0}, 205},      // byte out of range
+    {4, {50, 50, 50, 50}, 200},
+    {3, {7, 8, 9, 0}, 25},         // bad checksum
+    {1, {99, 0, 0, 0}, 99},
+    {4, {100, 101, 0, 0}, 201},    // byte out of range
+    {2, {40, 2, 0, 0}, 42},
+};
+
+static constexpr uint8_t ERR_PASSES = 8;
+
+#ifndef ERR_SJLJ
+static uint8_t check_byte(uint8_t v) {
+    return v > 100 ? ERR_RANGE : ERR_NONE;
+}
+
+static uint8_t check_fields(const Record &r, uint8_t *sum) {
+    uint8_t s = 0;
+    for (uint8_t i = 0; i < r.len; i++) {
+        uint8_t e = check_byte(r.data[i]);
+        if (e != ERR_NONE) return e;
+        s += r.data[i];
+    }
+    *sum = s;
+    return ERR_NONE;
+}
+
+static uint8_t decode_record(const Record &r, uint8_t *val) {
+    uint8_t s;
+    uint8_t e = check_fields(r, &s);
+    if (e != ERR_NONE) return e;
+    if (s != r.sum) return ERR_CHECK;
+    *val = s;
+    return ERR_NONE;
+}
+#else
+static void check_byte(uint8_t v) {
+    if (v > 100) exc_throw(ERR_RANGE);
+}
+
+static uint8_t check_fields(const Record &r) {
+    uint8_t s = 0;
+    for (uint8_t i = 0; i < r.len; i++) {
+        check_byte(r.data[i]);
+        s += r.data[i];
+    }
+    return s;
+}
+
+static uint8_t decode_record(const Record &r) {
+    uint8_t s = check_fields(r);
+    if (s != r.sum) exc_throw(ERR_CHECK);
+    return s;
+}
+#endif
+
+static void test_error_propagation() {
+    uint16_t total = 0;
+    uint8_t range = 0, check = 0;
+
+    for (uint8_t pass = 0; pass < ERR_PASSES; pass++) {
+        for (const Record &r : records) {
+#ifndef ERR_SJLJ
+            uint8_t v;
+            uint8_t e = decode_record(r, &v);
+            if (e == ERR_NONE) total += v;
+            else if (e == ERR_RANGE) range++;
+            else check++;
+#else
+            i8085::exc_try([&] { total += decode_record(r); },
+                           [&](int e) {
+                               if (e == ERR_RANGE) range++;
+                               else check++;
+                           });
+#endif
+        }
+    }
+    emit(total & 0xFF);  // [38] = 0xD8 (8 * 411 = 3288)
+    emit(total >> 8);    // [39] = 0x0C
+    emit(range);         // [40] = 16
+    emit(check);         // [41] = 8
+}
+
 // =========================================================================
 
 extern "C" int main() {
@@ -382,9 +489,12 @@ extern "C" int main() {
     // 8. Lambda comparator
     test_lambda_comparator();      // [36..37]
 
+    // 9. Error propagation
+    test_error_propagation();      // [38..41]
+
     // Sentinel
-    emit(0xBE);   // [38]
-    emit(0xEF);   // [39]
+    emit(0xBE);   // [42]
+    emit(0xEF);   // [43]
 
     __asm__ volatile("hlt");
     return 0;
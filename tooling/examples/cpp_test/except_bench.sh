@@ -0,0 +1,75 @@
+#!/usr/bin/env bash
+# Build cpp_stress.cpp twice, once with status-code error propagation
+# (default) and once with -DERR_SJLJ (<i8085/except.h>), check both
+# produce the expected 44 bytes at 0xE000 and report ROM and clocks.
+# Only section 9 differs between the builds, so the deltas are the cost
+# of the error model (see builtins/setjmp.S).
+#
+# Usage: except_bench.sh [-O2|-Oz|...]   (default -Oz)
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")/../../.." && pwd)"
+TOOLCHAIN="${ROOT}/llvm-project/build-clang-8085/bin"
+
+CLANG="${CLANG:-${TOOLCHAIN}/clang}"
+LLD="${LLD:-${TOOLCHAIN}/ld.lld}"
+OBJCOPY="${LLVM_OBJCOPY:-${TOOLCHAIN}/llvm-objcopy}"
+SIZE="${LLVM_SIZE:-${TOOLCHAIN}/llvm-size}"
+TRACE="${TRACE:-$ROOT/i8085-trace/build/i8085-trace}"
+
+SYSROOT="${ROOT}/sysroot"
+CRT="${CRT:-$SYSROOT/crt/crt0.S}"
+LIBGCC="${LIBGCC:-$SYSROOT/lib/libgcc.a}"
+LIBC="${LIBC:-$SYSROOT/lib/libc.a}"
+LINKER="$SYSROOT/ldscripts/i8085-16kram-48krom.ld"
+CLANG_EXTRA="${CLANG_EXTRA:-}"
+
+OPT="${1:--Oz}"
+SRC="${ROOT}/tooling/examples/cpp_test/cpp_stress.cpp"
+OUT="${ROOT}/tooling/examples/cpp_test/build/except"
+EXPECTED="1e0f038e0721280721010303010001030102030a050b16050a0f2c370341033d393f0146320ad80c1008beef"
+
+for tool in "${CLANG}" "${LLD}" "${OBJCOPY}" "${SIZE}" "${TRACE}"; do
+  if [[ ! -x "${tool}" ]]; then
+    echo "Error: missing tool ${tool}" >&2
+    exit 1
+  fi
+done
+
+mkdir -p "${OUT}"
+# shellcheck disable=SC2086
+"${CLANG}" --target=i8085-unknown-elf -ffreestanding -fno-builtin ${OPT} \
+  ${CLANG_EXTRA} -c "${CRT}" -o "${OUT}/crt0.o"
+
+# build <name> [defines...]: sets rom, clk, ok
+build() {
+  local name="$1"
+  shift
+  # shellcheck disable=SC2086
+  "${CLANG}" --target=i8085-unknown-elf -ffreestanding -fno-builtin ${OPT} \
+    ${CLANG_EXTRA} -fno-exceptions -fno-rtti -fno-threadsafe-statics \
+    -nostdinc++ -isystem "${SYSROOT}/include/c++/v1" \
+    -isystem "${SYSROOT}/include" -std=c++17 "$@" \
+    -c "${SRC}" -o "${OUT}/${name}.o"
+  "${LLD}" -m i8085elf --gc-sections -T "${LINKER}" \
+    -o "${OUT}/${name}.elf" "${OUT}/crt0.o" "${OUT}/${name}.o" \
+    "${LIBGCC}" "${LIBC}" "${LIBGCC}"
+  "${OBJCOPY}" -O binary "${OUT}/${name}.elf" "${OUT}/${name}.bin"
+
+  rom="$("${SIZE}" -A "${OUT}/${name}.elf" | awk '$1 == ".text" || $1 == ".rodata" { s += $2 } END { print s + 0 }')"
+  clk="$("${TRACE}" -e 0x0000 -l 0x0000 -n 5000000 -S -q -d 0xE000:44 \
+    "${OUT}/${name}.bin" 2>"${OUT}/${name}.dump.txt" | grep -o '"clk":[0-9]*' | cut -d: -f2)"
+  local got
+  got="$(sed -n 's/^ *[0-9A-Fa-f]\{4\}: *\([^|]*\).*/\1/p' "${OUT}/${name}.dump.txt" | tr -d ' \n' | tr 'A-F' 'a-f')"
+  if [[ "${got}" == "${EXPECTED}" ]]; then ok=PASS; else ok=FAIL; fi
+}
+
+build status
+base_rom="${rom}"
+base_clk="${clk}"
+printf "%-8s %6s %9s %s\n" "model" "ROM" "clocks" "output"
+printf "%-8s %6d %9d %s\n" status "${rom}" "${clk}" "${ok}"
+
+build sjlj -DERR_SJLJ
+printf "%-8s %6d %9d %s  (%+d bytes, %+d clocks)\n" sjlj "${rom}" "${clk}" "${ok}" \
+  $((rom - base_rom)) $((clk - base_clk))
@@ -0,0 +1,96 @@
+/*
+ * CRC / checksum throughput benchmark for i8085.
+ *
+ * Runs every kernel in builtins/crc.S (crc8, crc16_ccitt and crc32 in
+ * their _tab/_nib/_bit variants, fletcher16, adler32) over a 1 KB
+ * pseudo-random buffer, ROUNDS times each with the result chained, and
+ * checks the final values.
+ *
+ * Built with -DKERNEL=n only kernel n (1..11, see KERNELS below) is
+ * called, so --gc-sections keeps just that kernel and its table;
+ * -DKERNEL=0 calls none (baseline).  run.sh builds the whole matrix and
+ * reports ROM bytes and clocks per byte for each kernel.
+ *
+ * Output at 0x0200 (16-bit words):
+ *   +0 pass count
+ *   +2 total tests
+ *   +4 bytes processed
+ * Halts on success.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define OUTPUT_ADDR 0x0200
+#define BUF_SIZE 1024
+#define ROUNDS 2
+
+uint8_t crc8_tab(uint8_t, const void *, size_t);
+uint8_t crc8_nib(uint8_t, const void *, size_t);
+uint8_t crc8_bit(uint8_t, const void *, size_t);
+uint16_t crc16_ccitt_tab(uint16_t, const void *, size_t);
+uint16_t crc16_ccitt_nib(uint16_t, const void *, size_t);
+uint16_t crc16_ccitt_bit(uint16_t, const void *, size_t);
+uint32_t crc32_tab(uint32_t, const void *, size_t);
+uint32_t crc32_nib(uint32_t, const void *, size_t);
+uint32_t crc32_bit(uint32_t, const void *, size_t);
+uint16_t fletcher16(uint16_t, const void *, size_t);
+uint32_t adler32(uint32_t, const void *, size_t);
+
+/* id, width, function, initial value, result after ROUNDS passes */
+#define KERNELS(X)                                  \
+    X(1, 8, crc8_tab, 0, 0xE1)                      \
+    X(2, 8, crc8_nib, 0, 0xE1)                      \
+    X(3, 8, crc8_bit, 0, 0xE1)                      \
+    X(4, 16, crc16_ccitt_tab, 0xFFFF, 0xAEFE)       \
+    X(5, 16, crc16_ccitt_nib, 0xFFFF, 0xAEFE)       \
+    X(6, 16, crc16_ccitt_bit, 0xFFFF, 0xAEFE)       \
+    X(7, 32, crc32_tab, 0, 0xF0410921UL)            \
+    X(8, 32, crc32_nib, 0, 0xF0410921UL)            \
+    X(9, 32, crc32_bit, 0, 0xF0410921UL)            \
+    X(10, 16, fletcher16, 0, 0x7C80)                \
+    X(11, 32, adler32, 1, 0x31390CADUL)
+
+#ifdef KERNEL
+#define WANT(id) ((id) == KERNEL)
+#else
+#define WANT(id) 1
+#endif
+
+__attribute__((noinline)) static void halt_ok(void) { __asm__ volatile("hlt"); }
+__attribute__((noinline)) static void fail_loop(void) { for (;;) {} }
+
+static uint8_t buf[BUF_SIZE];
+static uint16_t pass, total, bytes_done;
+
+#define RUN(id, width, fn, init, expected)                  \
+    if (WANT(id)) {                                         \
+        uint##width##_t v_ = (init);                        \
+        uint8_t r_;                                         \
+        for (r_ = 0; r_ < ROUNDS; r_++) {                   \
+            v_ = fn(v_, buf, BUF_SIZE);                     \
+            bytes_done += BUF_SIZE;                         \
+        }                                                   \
+        if (v_ == (uint##width##_t)(expected)) pass++;      \
+        total++;                                            \
+    }
+
+int main(void) {
+    volatile uint16_t *output = (volatile uint16_t *)OUTPUT_ADDR;
+    uint16_t i, x = 1;
+
+    for (i = 0; i < BUF_SIZE; i++) {
+        x = x * 25173u + 13849u;
+        buf[i] = (uint8_t)(x >> 8);
+    }
+
+    KERNELS(RUN)
+
+    output[1] = total;
+    output[2] = bytes_done;
+    output[0] = pass;
+
+    if (pass == total) halt_ok();
+    fail_loop();
+    return 0;
+}
@@ -0,0 +1,78 @@
+#!/usr/bin/env bash
+# Build crc_bench once per kernel and report the ROM/speed matrix: bytes
+# of .text + .rodata the kernel adds over the no-kernel baseline, and
+# clocks per byte (see builtins/crc.S and docs/RUNTIME_LIBRARY.md).
+#
+# The numbers are for the libgcc.a being linked; rebuild it with
+# build-libgcc.sh --undoc to measure the UNDOC argument loads.
+#
+# Usage: run.sh [-O2|-Oz|...]   (default -Oz)
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")/../../.." && pwd)"
+TOOLCHAIN="${ROOT}/llvm-project/build-clang-8085/bin"
+
+CLANG="${CLANG:-${TOOLCHAIN}/clang}"
+LLD="${LLD:-${TOOLCHAIN}/ld.lld}"
+OBJCOPY="${LLVM_OBJCOPY:-${TOOLCHAIN}/llvm-objcopy}"
+SIZE="${LLVM_SIZE:-${TOOLCHAIN}/llvm-size}"
+TRACE="${TRACE:-$ROOT/i8085-trace/build/i8085-trace}"
+
+CRT="${CRT:-$ROOT/sysroot/crt/crt0.S}"
+LIBGCC="${LIBGCC:-$ROOT/sysroot/lib/libgcc.a}"
+LIBC="${LIBC:-$ROOT/sysroot/lib/libc.a}"
+LINKER="$ROOT/sysroot/ldscripts/i8085-16kram-48krom.ld"
+CLANG_EXTRA="${CLANG_EXTRA:-}"
+
+OPT="${1:--Oz}"
+SRC="${ROOT}/tooling/examples/crc_bench/crc_bench.c"
+OUT="${ROOT}/tooling/examples/crc_bench/build/matrix"
+
+KERNELS=(crc8_tab crc8_nib crc8_bit crc16_ccitt_tab crc16_ccitt_nib
+         crc16_ccitt_bit crc32_tab crc32_nib crc32_bit fletcher16 adler32)
+
+for tool in "${CLANG}" "${LLD}" "${OBJCOPY}" "${SIZE}" "${TRACE}"; do
+  if [[ ! -x "${tool}" ]]; then
+    echo "Error: missing tool ${tool}" >&2
+    exit 1
+  fi
+done
+
+mkdir -p "${OUT}"
+# shellcheck disable=SC2086
+"${CLANG}" --target=i8085-unknown-elf -ffreestanding -fno-builtin ${OPT} \
+  ${CLANG_EXTRA} -c "${CRT}" -o "${OUT}/crt0.o"
+
+# build <id>: sets rom, clk, pass, total, bytes
+build() {
+  local name="k$1"
+  # shellcheck disable=SC2086
+  "${CLANG}" --target=i8085-unknown-elf -ffreestanding -fno-builtin ${OPT} \
+    ${CLANG_EXTRA} -DKERNEL="$1" -c "${SRC}" -o "${OUT}/${name}.o"
+  "${LLD}" -m i8085elf --gc-sections -T "${LINKER}" \
+    -o "${OUT}/${name}.elf" "${OUT}/crt0.o" "${OUT}/${name}.o" \
+    "${LIBGCC}" "${LIBC}" "${LIBGCC}"
+  "${OBJCOPY}" -O binary "${OUT}/${name}.elf" "${OUT}/${name}.bin"
+
+  rom="$("${SIZE}" -A "${OUT}/${name}.elf" | awk '$1 == ".text" || $1 == ".rodata" { s += $2 } END { print s + 0 }')"
+  clk="$("${TRACE}" -e 0x0000 -l 0x0000 -n 50000000 -S -q -d 0x0200:6 \
+    "${OUT}/${name}.bin" 2>"${OUT}/${name}.dump.txt" | grep -o '"clk":[0-9]*' | cut -d: -f2)"
+  # pass, total, bytes (little-endian words)
+  local words
+  read -r -a words < <(sed -n 's/^ *[0-9A-Fa-f]\{4\}: *\([^|]*\).*/\1/p' "${OUT}/${name}.dump.txt" | tr '\n' ' ')
+  pass=$((16#${words[1]}${words[0]}))
+  total=$((16#${words[3]}${words[2]}))
+  bytes=$((16#${words[5]}${words[4]}))
+}
+
+build 0
+base_rom="${rom}"
+base_clk="${clk}"
+
+printf "%-16s %6s %8s %s\n" "kernel" "ROM" "clk/byte" "pass"
+for i in "${!KERNELS[@]}"; do
+  build $((i + 1))
+  awk -v n="${KERNELS[$i]}" -v r="$((rom - base_rom))" -v c="$((clk - base_clk))" \
+      -v b="${bytes}" -v p="${pass}" -v t="${total}" \
+    'BEGIN { printf "%-16s %6d %8.1f %d/%d\n", n, r, (b > 0 ? c / b : 0), p, t }'
+done
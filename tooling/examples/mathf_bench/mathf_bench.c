@@ -0,0 +1,164 @@
+/*
+ * Single-precision libm benchmark for i8085.
+ *
+ * Exercises sqrtf, sinf/cosf, atan2f, expf and logf in the patterns
+ * a motion-control loop uses every tick: vector magnitude and heading,
+ * rotation of a setpoint, and an exponential filter / log-scale gain.
+ * Linking against libgcc.a picks up the hand-written builtins/mathf.S
+ * versions; results are checked against host-computed values with a
+ * small tolerance so the same program can time picolibc's C versions.
+ *
+ * Uses volatile to prevent constant folding.
+ *
+ * Output: 4-byte pass count at 0x0200, per-test flags at 0x0204.
+ * Halts on success.
+ */
+
+#include <stdint.h>
+
+float sqrtf(float);
+float sinf(float);
+float cosf(float);
+float atan2f(float, float);
+float expf(float);
+float logf(float);
+
+#define OUTPUT_ADDR 0x0200
+#define TOTAL_TESTS 5
+#define TICKS 8
+
+__attribute__((noinline)) static void halt_ok(void) { __asm__ volatile("hlt"); }
+__attribute__((noinline)) static void fail_loop(void) { for (;;) {} }
+
+static int near(float a, float b, float tol) {
+    float d = a - b;
+    if (d < 0.0f) d = -d;
+    return d <= tol;
+}
+
+/*
+ * Test 1: Vector magnitude of (3k, 4k) for k = 1..TICKS.
+ * sqrtf(9k^2 + 16k^2) = 5k exactly (sqrtf is correctly rounded).
+ */
+__attribute__((noinline))
+static int test_magnitude(void) {
+    volatile float three = 3.0f, four = 4.0f, five = 5.0f;
+    float k = 0.0f;
+    int i;
+    for (i = 0; i < TICKS; i++) {
+        k += 1.0f;
+        float dx = three * k, dy = four * k;
+        if (sqrtf(dx * dx + dy * dy) != five * k)
+            return 0;
+    }
+    return 1;
+}
+
+/*
+ * Test 2: Heading of a point walking around the unit circle.
+ * atan2f(sin t, cos t) must give back t for t in (-pi, pi).
+ */
+__attribute__((noinline))
+static int test_heading(void) {
+    volatile float step = 0.7f, start = -2.8f;
+    float t = start;
+    int i;
+    for (i = 0; i < TICKS; i++) {
+        float h = atan2f(sinf(t), cosf(t));
+        if (!near(h, t, 1.0e-6f))
+            return 0;
+        t += step;
+    }
+    return 1;
+}
+
+/*
+ * Test 3: Rotate (1, 0) by 0.25 rad TICKS times (2 rad total).
+ * Expected: (cos 2, sin 2) = (-0.41614684, 0.90929743).
+ */
+__attribute__((noinline))
+static int test_rotation(void) {
+    volatile float a = 0.25f;
+    float c = cosf(a), s = sinf(a);
+    float x = 1.0f, y = 0.0f;
+    int i;
+    for (i = 0; i < TICKS; i++) {
+        float nx = x * c - y * s;
+        y = x * s + y * c;
+        x = nx;
+    }
+    return near(x, -0.41614684f, 1.0e-5f) && near(y, 0.90929743f, 1.0e-5f);
+}
+
+/*
+ * Test 4: First-order filter coefficient alpha = 1 - exp(-dt/tau)
+ * recomputed every tick for a sweeping tau, accumulated.
+ * Expected sum for tau = 1..TICKS, dt = 0.5: 1.1903322.
+ */
+__attribute__((noinline))
+static int test_filter(void) {
+    volatile float dt = 0.5f;
+    float tau = 0.0f, sum = 0.0f;
+    int i;
+    for (i = 0; i < TICKS; i++) {
+        tau += 1.0f;
+        sum += 1.0f - expf(-dt / tau);
+    }
+    return near(sum, 1.1903322f, 1.0e-5f);
+}
+
+/*
+ * Test 5: Log-scale gain: logf/expf round trip over a decade sweep.
+ * expf(logf(x)) must return x to within 1e-6 relative.
+ */
+__attribute__((noinline))
+static int test_logexp(void) {
+    volatile float x0 = 0.01f, mul = 3.7f;
+    float x = x0;
+    int i;
+    for (i = 0; i < TICKS; i++) {
+        float r = expf(logf(x));
+        if (!near(r, x, x * 1.0e-6f))
+            return 0;
+        x *= mul;
+    }
+    return 1;
+}
+
+int main(void) {
+    volatile uint32_t *output = (volatile uint32_t *)OUTPUT_ADDR;
+    volatile uint16_t pass = 0;
+
+    /* Per-test pass/fail flags at 0x0204..0x0208 */
+    volatile uint8_t *flags = (volatile uint8_t *)0x0204;
+    int r;
+
+    r = test_magnitude();
+    flags[0] = r;
+    if (r) pass++;
+
+    r = test_heading();
+    flags[1] = r;
+    if (r) pass++;
+
+    r = test_rotation();
+    flags[2] = r;
+    if (r) pass++;
+
+    r = test_filter();
+    flags[3] = r;
+    if (r) pass++;
+
+    r = test_logexp();
+    flags[4] = r;
+    if (r) pass++;
+
+    *output = (uint32_t)pass;
+
+    if (pass == TOTAL_TESTS) {
+        halt_ok();
+    }
+
+    fail_loop();
+    return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * printf throughput benchmark for i8085.
+ *
+ * Formats the kind of lines logging and display code produces (counters,
+ * hex dumps, padded fields, long timestamps) with snprintf, ROUNDS times
+ * each, and checks every result against the expected text.
+ *
+ * The default build uses the integer-only stdio variant picolibc is
+ * configured with (__IO_DEFAULT 'i').  Built with
+ * -DPICOLIBC_FLOAT_PRINTF_SCANF and linked with
+ * --defsym=vfprintf=__f_vfprintf it also formats binary32 values through
+ * picolibc's float-only engine (run.sh builds both).
+ *
+ * Output at 0x0200 (16-bit words):
+ *   +0 pass count
+ *   +2 total tests
+ *   +4 bytes formatted
+ * Halts on success.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define OUTPUT_ADDR 0x0200
+#define ROUNDS 8
+
+__attribute__((noinline)) static void halt_ok(void) { __asm__ volatile("hlt"); }
+__attribute__((noinline)) static void fail_loop(void) { for (;;) {} }
+
+static char buf[48];
+static uint16_t bytes_out;
+
+static int same(const char *a, const char *b) {
+    while (*a && *a == *b) { a++; b++; }
+    return *a == *b;
+}
+
+/* Volatile operands prevent constant folding */
+static volatile int16_t vi = -1234;
+static volatile uint16_t vu = 65535u;
+static volatile uint16_t vx = 0xBEEF;
+static volatile int32_t vl = -2147483647L - 1;
+static volatile uint32_t vms = 4000000000UL;
+static volatile uint8_t vb = 7;
+
+#define RUN(expected, ...)                                   \
+    do {                                                     \
+        uint8_t r_;                                          \
+        int ok_ = 1, n_ = 0;                                 \
+        for (r_ = 0; r_ < ROUNDS; r_++) {                    \
+            n_ = snprintf(buf, sizeof(buf), __VA_ARGS__);    \
+            if (!same(buf, expected)) ok_ = 0;               \
+            bytes_out += (uint16_t)n_;                       \
+        }                                                    \
+        if (ok_ && n_ == (int)sizeof(expected) - 1) pass++;  \
+        total++;                                             \
+    } while (0)
+
+int main(void) {
+    volatile uint16_t *output = (volatile uint16_t *)OUTPUT_ADDR;
+    uint16_t pass = 0, total = 0;
+
+    RUN("-1234", "%d", vi);
+    RUN("65535", "%u", vu);
+    RUN("beef BEEF", "%x %X", vx, vx);
+    RUN("[  7] [007] [7  ]", "[%3u] [%03u] [%-3u]", vb, vb, vb);
+    RUN("-2147483648", "%ld", vl);
+    RUN("t=4000000000ms", "t=%lums", vms);
+    RUN("0x0000beef", "0x%08lx", (uint32_t)vx);
+    RUN("adc[7]=-1234 max=65535", "adc[%u]=%d max=%u", vb, vi, vu);
+    RUN("temp: 42 C, ok", "%s: %d %c, %s", "temp", 42, 'C', "ok");
+
+#ifdef PICOLIBC_FLOAT_PRINTF_SCANF
+    {
+        static volatile float f1 = 1.5f, f2 = -0.25f, f3 = 1234.5f,
+                              f4 = 0.0f, f5 = 100.0f;
+        RUN("1.50", "%.2f", printf_float(f1));
+        RUN("-0.250", "%.3f", printf_float(f2));
+        RUN("1234.5", "%.1f", printf_float(f3));
+        RUN("0.000000", "%f", printf_float(f4));
+        RUN("v=100.00 V", "v=%.2f V", printf_float(f5));
+    }
+#endif
+
+    output[1] = total;
+    output[2] = bytes_out;
+    output[0] = pass;
+
+    if (pass == total) halt_ok();
+    fail_loop();
+    return 0;
+}
@@ -0,0 +1,68 @@
+#!/usr/bin/env bash
+# Build printf_bench against both stdio variants and report code size and
+# clocks: the integer-only default and the binary32 float variant selected
+# with --defsym (see picolibc-i8085/BUILDING.md).
+#
+# Usage: run.sh [-O2|-Oz|...]   (default -Oz)
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")/../../.." && pwd)"
+TOOLCHAIN="${ROOT}/llvm-project/build-clang-8085/bin"
+
+CLANG="${CLANG:-${TOOLCHAIN}/clang}"
+LLD="${LLD:-${TOOLCHAIN}/ld.lld}"
+OBJCOPY="${LLVM_OBJCOPY:-${TOOLCHAIN}/llvm-objcopy}"
+SIZE="${LLVM_SIZE:-${TOOLCHAIN}/llvm-size}"
+TRACE="${TRACE:-$ROOT/i8085-trace/build/i8085-trace}"
+
+CRT="${CRT:-$ROOT/sysroot/crt/crt0.S}"
+LIBGCC="${LIBGCC:-$ROOT/sysroot/lib/libgcc.a}"
+LIBC="${LIBC:-$ROOT/sysroot/lib/libc.a}"
+LINKER="$ROOT/sysroot/ldscripts/i8085-16kram-48krom.ld"
+CLANG_EXTRA="${CLANG_EXTRA:-}"
+
+OPT="${1:--Oz}"
+SRC="${ROOT}/tooling/examples/printf_bench/printf_bench.c"
+OUT="${ROOT}/tooling/examples/printf_bench/build/variants"
+
+for tool in "${CLANG}" "${LLD}" "${OBJCOPY}" "${SIZE}" "${TRACE}"; do
+  if [[ ! -x "${tool}" ]]; then
+    echo "Error: missing tool ${tool}" >&2
+    exit 1
+  fi
+done
+
+mkdir -p "${OUT}"
+# shellcheck disable=SC2086
+"${CLANG}" --target=i8085-unknown-elf -ffreestanding -fno-builtin ${OPT} \
+  ${CLANG_EXTRA} -c "${CRT}" -o "${OUT}/crt0.o"
+
+# variant <name> <cflags> <ldflags>
+variant() {
+  local name="$1"
+  # shellcheck disable=SC2086
+  "${CLANG}" --target=i8085-unknown-elf -ffreestanding -fno-builtin ${OPT} \
+    ${CLANG_EXTRA} $2 -c "${SRC}" -o "${OUT}/${name}.o"
+  # shellcheck disable=SC2086
+  "${LLD}" -m i8085elf --gc-sections -T "${LINKER}" $3 \
+    -o "${OUT}/${name}.elf" "${OUT}/crt0.o" "${OUT}/${name}.o" \
+    "${LIBGCC}" "${LIBC}" "${LIBGCC}"
+  "${OBJCOPY}" -O binary "${OUT}/${name}.elf" "${OUT}/${name}.bin"
+
+  local text clk words
+  text="$("${SIZE}" -A "${OUT}/${name}.elf" | awk '$1 == ".text" { print $2 }')"
+  clk="$("${TRACE}" -e 0x0000 -l 0x0000 -n 50000000 -S -q -d 0x0200:6 \
+    "${OUT}/${name}.bin" 2>"${OUT}/${name}.dump.txt" | grep -o '"clk":[0-9]*' | cut -d: -f2)"
+  # pass, total, bytes (little-endian words)
+  read -r -a words < <(sed -n 's/^ *[0-9A-Fa-f]\{4\}: *\([^|]*\).*/\1/p' "${OUT}/${name}.dump.txt" | tr '\n' ' ')
+  local pass=$((16#${words[1]}${words[0]}))
+  local total=$((16#${words[3]}${words[2]}))
+  local bytes=$((16#${words[5]}${words[4]}))
+  awk -v n="${name}" -v t="${text}" -v c="${clk}" -v p="${pass}" -v tt="${total}" -v b="${bytes}" \
+    'BEGIN { printf "%-8s %8d %11d %7.1f %4d/%d\n", n, t, c, (b > 0 ? c / b : 0), p, tt }'
+}
+
+printf "%-8s %8s %11s %7s %s\n" "variant" ".text" "clocks" "clk/ch" "pass"
+variant integer "" ""
+variant float "-DPICOLIBC_FLOAT_PRINTF_SCANF" \
+  "--defsym=vfprintf=__f_vfprintf --defsym=vfscanf=__f_vfscanf"
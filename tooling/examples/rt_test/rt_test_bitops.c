@@ -0,0 +1,113 @@
+/*
+ * clz / ctz / popcount unit tests for i8085
+ *
+ * Tests __clzsi2, __clzdi2, __ctzsi2, __ctzdi2, __popcountsi2 and
+ * __popcountdi2 (builtins/bitops.S byte scans) against a bit-by-bit
+ * reference: single bits at every position, values confined to either
+ * half of a 64-bit word, all-ones, zero and a pseudo-random sweep.
+ */
+
+#include "rt_test.h"
+
+int __clzsi2(uint32_t);
+int __clzdi2(uint64_t);
+int __ctzsi2(uint32_t);
+int __ctzdi2(uint64_t);
+int __popcountsi2(uint32_t);
+int __popcountdi2(uint64_t);
+
+static int ref_clz(uint64_t x, int bits) {
+    int n = 0;
+    uint64_t top = (uint64_t)1 << (bits - 1);
+    while (n < bits && !(x & top)) {
+        x <<= 1;
+        n++;
+    }
+    return n;
+}
+
+static int ref_ctz(uint64_t x, int bits) {
+    int n = 0;
+    while (n < bits && !(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+}
+
+static int ref_pop(uint64_t x) {
+    int n = 0;
+    while (x) {
+        n += (int)(x & 1);
+        x >>= 1;
+    }
+    return n;
+}
+
+static void check32(uint32_t x) {
+    CHECK(__clzsi2(x) == ref_clz(x, 32));
+    CHECK(__ctzsi2(x) == ref_ctz(x, 32));
+    CHECK(__popcountsi2(x) == ref_pop(x));
+}
+
+static void check64(uint64_t x) {
+    CHECK(__clzdi2(x) == ref_clz(x, 64));
+    CHECK(__ctzdi2(x) == ref_ctz(x, 64));
+    CHECK(__popcountdi2(x) == ref_pop(x));
+}
+
+/* Volatile prevents constant folding */
+static volatile uint32_t v32;
+static volatile uint64_t v64;
+
+int main(void) {
+    uint32_t seed = 1;
+    uint8_t i;
+
+    test_init();
+
+    /* ============ zero and all-ones ============ */
+    v32 = 0;
+    check32(v32);
+    CHECK(__clzsi2(v32) == 32 && __ctzsi2(v32) == 32);
+    v64 = 0;
+    check64(v64);
+    CHECK(__clzdi2(v64) == 64 && __ctzdi2(v64) == 64);
+    v32 = 0xFFFFFFFFUL;
+    check32(v32);
+    v64 = 0xFFFFFFFFFFFFFFFFULL;
+    check64(v64);
+
+    /* ============ single bits ============ */
+    for (i = 0; i < 32; i++) {
+        v32 = (uint32_t)1 << i;
+        check32(v32);
+    }
+    for (i = 0; i < 64; i++) {
+        v64 = (uint64_t)1 << i;
+        check64(v64);
+    }
+
+    /* ============ one half of a 64-bit word empty ============ */
+    v64 = 0x0000000012345678ULL;
+    check64(v64);
+    v64 = 0x1234567800000000ULL;
+    check64(v64);
+    v64 = 0x0000000100000000ULL;
+    check64(v64);
+    v64 = 0x0000000080000000ULL;
+    check64(v64);
+
+    /* ============ pseudo-random ============ */
+    for (i = 0; i < 40; i++) {
+        seed = seed * 1103515245UL + 12345UL;
+        v32 = seed >> (i & 31);
+        check32(v32);
+        v64 = ((uint64_t)seed << (i & 31)) ^ seed;
+        check64(v64);
+    }
+
+    /* Halt -- results readable at 0x0200 */
+    __asm__ volatile("hlt");
+    return 0;
+}
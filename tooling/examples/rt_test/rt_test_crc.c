@@ -0,0 +1,120 @@
+/*
+ * CRC and checksum unit tests for i8085
+ *
+ * Tests builtins/crc.S: every variant of crc8, crc16_ccitt and crc32
+ * against the standard check values, chained calls, zero length and a
+ * buffer longer than 256 bytes (the split loop counters), plus
+ * fletcher16 and adler32.
+ */
+
+#include <stddef.h>
+
+#include "rt_test.h"
+
+uint8_t crc8(uint8_t, const void *, size_t);
+uint8_t crc8_tab(uint8_t, const void *, size_t);
+uint8_t crc8_nib(uint8_t, const void *, size_t);
+uint8_t crc8_bit(uint8_t, const void *, size_t);
+uint16_t crc16_ccitt(uint16_t, const void *, size_t);
+uint16_t crc16_ccitt_tab(uint16_t, const void *, size_t);
+uint16_t crc16_ccitt_nib(uint16_t, const void *, size_t);
+uint16_t crc16_ccitt_bit(uint16_t, const void *, size_t);
+uint32_t crc32(uint32_t, const void *, size_t);
+uint32_t crc32_tab(uint32_t, const void *, size_t);
+uint32_t crc32_nib(uint32_t, const void *, size_t);
+uint32_t crc32_bit(uint32_t, const void *, size_t);
+uint16_t fletcher16(uint16_t, const void *, size_t);
+uint32_t adler32(uint32_t, const void *, size_t);
+
+typedef uint8_t (*crc8_fn)(uint8_t, const void *, size_t);
+typedef uint16_t (*crc16_fn)(uint16_t, const void *, size_t);
+typedef uint32_t (*crc32_fn)(uint32_t, const void *, size_t);
+
+static const char check[] = "123456789";
+static uint8_t big[600];
+
+/* Volatile length prevents constant folding */
+static volatile size_t vlen;
+
+static void test_crc8(crc8_fn f) {
+    vlen = 9;
+    CHECK(f(0, check, vlen) == 0xF4);
+    CHECK(f(f(0, check, 4), check + 4, 5) == 0xF4);
+    vlen = 0;
+    CHECK(f(0x5A, check, vlen) == 0x5A);
+    vlen = sizeof(big);
+    CHECK(f(0, big, vlen) == crc8_bit(0, big, vlen));
+}
+
+static void test_crc16(crc16_fn f) {
+    vlen = 9;
+    CHECK(f(0xFFFF, check, vlen) == 0x29B1);
+    CHECK(f(0, check, vlen) == 0x31C3);
+    CHECK(f(f(0xFFFF, check, 2), check + 2, 7) == 0x29B1);
+    vlen = 0;
+    CHECK(f(0x1234, check, vlen) == 0x1234);
+    vlen = sizeof(big);
+    CHECK(f(0xFFFF, big, vlen) == crc16_ccitt_bit(0xFFFF, big, vlen));
+}
+
+static void test_crc32(crc32_fn f) {
+    vlen = 9;
+    CHECK(f(0, check, vlen) == 0xCBF43926UL);
+    CHECK(f(f(0, check, 3), check + 3, 6) == 0xCBF43926UL);
+    vlen = 0;
+    CHECK(f(0xDEADBEEFUL, check, vlen) == 0xDEADBEEFUL);
+    vlen = 256;
+    CHECK(f(0, big, vlen) == crc32_bit(0, big, vlen));
+    vlen = sizeof(big);
+    CHECK(f(0, big, vlen) == crc32_bit(0, big, vlen));
+}
+
+int main(void) {
+    unsigned i;
+
+    test_init();
+
+    for (i = 0; i < sizeof(big); i++)
+        big[i] = (uint8_t)(i * 7 + (i >> 3));
+
+    /* ============ crc8 ============ */
+    test_crc8(crc8_tab);
+    test_crc8(crc8_nib);
+    test_crc8(crc8_bit);
+    test_crc8(crc8);
+
+    /* ============ crc16_ccitt ============ */
+    test_crc16(crc16_ccitt_tab);
+    test_crc16(crc16_ccitt_nib);
+    test_crc16(crc16_ccitt_bit);
+    test_crc16(crc16_ccitt);
+
+    /* ============ crc32 ============ */
+    test_crc32(crc32_tab);
+    test_crc32(crc32_nib);
+    test_crc32(crc32_bit);
+    test_crc32(crc32);
+
+    /* ============ fletcher16 ============ */
+    vlen = 5;
+    CHECK(fletcher16(0, "abcde", vlen) == 0xC8F0);
+    vlen = 6;
+    CHECK(fletcher16(0, "abcdef", vlen) == 0x2057);
+    CHECK(fletcher16(fletcher16(0, "abc", 3), "def", 3) == 0x2057);
+    vlen = 0;
+    CHECK(fletcher16(0x1234, "", vlen) == 0x1234);
+
+    /* ============ adler32 ============ */
+    vlen = 9;
+    CHECK(adler32(1, "Wikipedia", vlen) == 0x11E60398UL);
+    CHECK(adler32(1, check, vlen) == 0x091E01DEUL);
+    CHECK(adler32(adler32(1, check, 5), check + 5, 4) == 0x091E01DEUL);
+    for (i = 0; i < sizeof(big); i++)
+        big[i] = 0xFF;
+    vlen = sizeof(big);
+    CHECK(adler32(1, big, vlen) == 0xB71F55C7UL);
+
+    /* Halt -- results readable at 0x0200 */
+    __asm__ volatile("hlt");
+    return 0;
+}
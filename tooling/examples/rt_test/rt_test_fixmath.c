@@ -0,0 +1,219 @@
+/*
+ * Fixed-point runtime unit tests for i8085
+ *
+ * Tests the saturating add/sub/mul/div helpers in builtins/fixmath.S
+ * for Q7 (qq), Q15 (hq), Q8.8 and Q16.16.
+ *
+ * Expected values come from an exact host model: multiply rounds half
+ * up, divide rounds half away from zero, every result saturates, and
+ * division by zero saturates towards the sign of the dividend.
+ */
+
+#include "rt_test.h"
+
+int8_t  __ssaddqq3(int8_t, int8_t);
+int8_t  __sssubqq3(int8_t, int8_t);
+int8_t  __ssmulqq3(int8_t, int8_t);
+int8_t  __ssdivqq3(int8_t, int8_t);
+int16_t __ssaddhq3(int16_t, int16_t);
+int16_t __sssubhq3(int16_t, int16_t);
+int16_t __ssmulhq3(int16_t, int16_t);
+int16_t __ssdivhq3(int16_t, int16_t);
+int16_t __i8085_ssaddq8_8(int16_t, int16_t);
+int16_t __i8085_sssubq8_8(int16_t, int16_t);
+int16_t __i8085_ssmulq8_8(int16_t, int16_t);
+int16_t __i8085_ssdivq8_8(int16_t, int16_t);
+int32_t __i8085_ssaddq16_16(int32_t, int32_t);
+int32_t __i8085_sssubq16_16(int32_t, int32_t);
+int32_t __i8085_ssmulq16_16(int32_t, int32_t);
+int32_t __i8085_ssdivq16_16(int32_t, int32_t);
+
+/* Volatile operands prevent constant folding */
+static volatile int8_t  v8a, v8b;
+static volatile int16_t v16a, v16b;
+static volatile int32_t v32a, v32b;
+
+#define DEF_TEST8(m, fn) \
+    static void test_##m(uint8_t a, uint8_t b, uint8_t expected) { \
+        v8a = (int8_t)a; v8b = (int8_t)b; \
+        CHECK((uint8_t)fn(v8a, v8b) == expected); \
+    }
+#define DEF_TEST16(m, fn) \
+    static void test_##m(uint16_t a, uint16_t b, uint16_t expected) { \
+        v16a = (int16_t)a; v16b = (int16_t)b; \
+        CHECK((uint16_t)fn(v16a, v16b) == expected); \
+    }
+#define DEF_TEST32(m, fn) \
+    static void test_##m(uint32_t a, uint32_t b, uint32_t expected) { \
+        v32a = (int32_t)a; v32b = (int32_t)b; \
+        CHECK((uint32_t)fn(v32a, v32b) == expected); \
+    }
+
+DEF_TEST8(add_qq, __ssaddqq3)
+DEF_TEST8(sub_qq, __sssubqq3)
+DEF_TEST8(mul_qq, __ssmulqq3)
+DEF_TEST8(div_qq, __ssdivqq3)
+DEF_TEST16(add_hq, __ssaddhq3)
+DEF_TEST16(sub_hq, __sssubhq3)
+DEF_TEST16(mul_hq, __ssmulhq3)
+DEF_TEST16(div_hq, __ssdivhq3)
+DEF_TEST16(add_q8_8, __i8085_ssaddq8_8)
+DEF_TEST16(sub_q8_8, __i8085_sssubq8_8)
+DEF_TEST16(mul_q8_8, __i8085_ssmulq8_8)
+DEF_TEST16(div_q8_8, __i8085_ssdivq8_8)
+DEF_TEST32(add_q16_16, __i8085_ssaddq16_16)
+DEF_TEST32(sub_q16_16, __i8085_sssubq16_16)
+DEF_TEST32(mul_q16_16, __i8085_ssmulq16_16)
+DEF_TEST32(div_q16_16, __i8085_ssdivq16_16)
+
+int main(void) {
+    test_init();
+
+    /* ============ Q7 (short _Fract) ============ */
+    test_add_qq(0x40, 0x40, 0x7F);
+    test_add_qq(0x7F, 0x01, 0x7F);
+    test_add_qq(0x80, 0xFF, 0x80);
+    test_add_qq(0x60, 0x30, 0x7F);
+    test_add_qq(0x80, 0x80, 0x80);
+    test_add_qq(0xC0, 0x40, 0x00);
+    test_add_qq(0x20, 0x40, 0x60);
+    test_add_qq(0xE0, 0x70, 0x50);
+    test_sub_qq(0x40, 0x40, 0x00);
+    test_sub_qq(0x7F, 0x01, 0x7E);
+    test_sub_qq(0x80, 0xFF, 0x81);
+    test_sub_qq(0x60, 0x30, 0x30);
+    test_sub_qq(0x80, 0x80, 0x00);
+    test_sub_qq(0xC0, 0x40, 0x80);
+    test_sub_qq(0x20, 0x40, 0xE0);
+    test_sub_qq(0xE0, 0x70, 0x80);
+    test_mul_qq(0x40, 0x40, 0x20);
+    test_mul_qq(0x7F, 0x01, 0x01);
+    test_mul_qq(0x80, 0xFF, 0x01);
+    test_mul_qq(0x60, 0x30, 0x24);
+    test_mul_qq(0x80, 0x80, 0x7F);
+    test_mul_qq(0xC0, 0x40, 0xE0);
+    test_mul_qq(0x20, 0x40, 0x10);
+    test_mul_qq(0xE0, 0x70, 0xE4);
+    test_div_qq(0x40, 0x40, 0x7F);
+    test_div_qq(0x7F, 0x01, 0x7F);
+    test_div_qq(0x80, 0xFF, 0x7F);
+    test_div_qq(0x60, 0x30, 0x7F);
+    test_div_qq(0x80, 0x80, 0x7F);
+    test_div_qq(0xC0, 0x40, 0x80);
+    test_div_qq(0x20, 0x40, 0x40);
+    test_div_qq(0xE0, 0x70, 0xDB);
+
+    /* ============ Q15 (_Fract) ============ */
+    test_add_hq(0x4000, 0x4000, 0x7FFF);
+    test_add_hq(0x7FFF, 0x0001, 0x7FFF);
+    test_add_hq(0x8000, 0xFFFF, 0x8000);
+    test_add_hq(0x6000, 0x3000, 0x7FFF);
+    test_add_hq(0x8000, 0x8000, 0x8000);
+    test_add_hq(0xC000, 0x4000, 0x0000);
+    test_add_hq(0x2000, 0x4000, 0x6000);
+    test_add_hq(0x1234, 0xF000, 0x0234);
+    test_add_hq(0x0001, 0x4000, 0x4001);
+    test_sub_hq(0x4000, 0x4000, 0x0000);
+    test_sub_hq(0x7FFF, 0x0001, 0x7FFE);
+    test_sub_hq(0x8000, 0xFFFF, 0x8001);
+    test_sub_hq(0x6000, 0x3000, 0x3000);
+    test_sub_hq(0x8000, 0x8000, 0x0000);
+    test_sub_hq(0xC000, 0x4000, 0x8000);
+    test_sub_hq(0x2000, 0x4000, 0xE000);
+    test_sub_hq(0x1234, 0xF000, 0x2234);
+    test_sub_hq(0x0001, 0x4000, 0xC001);
+    test_mul_hq(0x4000, 0x4000, 0x2000);
+    test_mul_hq(0x7FFF, 0x0001, 0x0001);
+    test_mul_hq(0x8000, 0xFFFF, 0x0001);
+    test_mul_hq(0x6000, 0x3000, 0x2400);
+    test_mul_hq(0x8000, 0x8000, 0x7FFF);
+    test_mul_hq(0xC000, 0x4000, 0xE000);
+    test_mul_hq(0x2000, 0x4000, 0x1000);
+    test_mul_hq(0x1234, 0xF000, 0xFDBA);
+    test_mul_hq(0x0001, 0x4000, 0x0001);
+    test_div_hq(0x4000, 0x4000, 0x7FFF);
+    test_div_hq(0x7FFF, 0x0001, 0x7FFF);
+    test_div_hq(0x8000, 0xFFFF, 0x7FFF);
+    test_div_hq(0x6000, 0x3000, 0x7FFF);
+    test_div_hq(0x8000, 0x8000, 0x7FFF);
+    test_div_hq(0xC000, 0x4000, 0x8000);
+    test_div_hq(0x2000, 0x4000, 0x4000);
+    test_div_hq(0x1234, 0xF000, 0x8000);
+    test_div_hq(0x0001, 0x4000, 0x0002);
+
+    /* ============ Q8.8 ============ */
+    test_add_q8_8(0x0180, 0x0200, 0x0380);
+    test_add_q8_8(0x7F00, 0x0200, 0x7FFF);
+    test_add_q8_8(0x8100, 0x0200, 0x8300);
+    test_add_q8_8(0xFF80, 0x0080, 0x0000);
+    test_add_q8_8(0x0001, 0x0080, 0x0081);
+    test_add_q8_8(0x0300, 0x0200, 0x0500);
+    test_add_q8_8(0x7FFF, 0xFFFF, 0x7FFE);
+    test_add_q8_8(0x0100, 0x0000, 0x0100);
+    test_sub_q8_8(0x0180, 0x0200, 0xFF80);
+    test_sub_q8_8(0x7F00, 0x0200, 0x7D00);
+    test_sub_q8_8(0x8100, 0x0200, 0x8000);
+    test_sub_q8_8(0xFF80, 0x0080, 0xFF00);
+    test_sub_q8_8(0x0001, 0x0080, 0xFF81);
+    test_sub_q8_8(0x0300, 0x0200, 0x0100);
+    test_sub_q8_8(0x7FFF, 0xFFFF, 0x7FFF);
+    test_sub_q8_8(0x0100, 0x0000, 0x0100);
+    test_mul_q8_8(0x0180, 0x0200, 0x0300);
+    test_mul_q8_8(0x7F00, 0x0200, 0x7FFF);
+    test_mul_q8_8(0x8100, 0x0200, 0x8000);
+    test_mul_q8_8(0xFF80, 0x0080, 0xFFC0);
+    test_mul_q8_8(0x0001, 0x0080, 0x0001);
+    test_mul_q8_8(0x0300, 0x0200, 0x0600);
+    test_mul_q8_8(0x7FFF, 0xFFFF, 0xFF80);
+    test_mul_q8_8(0x0100, 0x0000, 0x0000);
+    test_div_q8_8(0x0180, 0x0200, 0x00C0);
+    test_div_q8_8(0x7F00, 0x0200, 0x3F80);
+    test_div_q8_8(0x8100, 0x0200, 0xC080);
+    test_div_q8_8(0xFF80, 0x0080, 0xFF00);
+    test_div_q8_8(0x0001, 0x0080, 0x0002);
+    test_div_q8_8(0x0300, 0x0200, 0x0180);
+    test_div_q8_8(0x7FFF, 0xFFFF, 0x8000);
+    test_div_q8_8(0x0100, 0x0000, 0x7FFF);
+
+    /* ============ Q16.16 ============ */
+    test_add_q16_16(0x00018000UL, 0x00020000UL, 0x00038000UL);
+    test_add_q16_16(0x7FFF0000UL, 0x00020000UL, 0x7FFFFFFFUL);
+    test_add_q16_16(0x80010000UL, 0x00020000UL, 0x80030000UL);
+    test_add_q16_16(0xFFFF8000UL, 0x00008000UL, 0x00000000UL);
+    test_add_q16_16(0x00000001UL, 0x00008000UL, 0x00008001UL);
+    test_add_q16_16(0x00030000UL, 0x00020000UL, 0x00050000UL);
+    test_add_q16_16(0x00000000UL, 0x00000000UL, 0x00000000UL);
+    test_add_q16_16(0x12345678UL, 0xFEDCBA98UL, 0x11111110UL);
+    test_add_q16_16(0x00010000UL, 0x00030000UL, 0x00040000UL);
+    test_sub_q16_16(0x00018000UL, 0x00020000UL, 0xFFFF8000UL);
+    test_sub_q16_16(0x7FFF0000UL, 0x00020000UL, 0x7FFD0000UL);
+    test_sub_q16_16(0x80010000UL, 0x00020000UL, 0x80000000UL);
+    test_sub_q16_16(0xFFFF8000UL, 0x00008000UL, 0xFFFF0000UL);
+    test_sub_q16_16(0x00000001UL, 0x00008000UL, 0xFFFF8001UL);
+    test_sub_q16_16(0x00030000UL, 0x00020000UL, 0x00010000UL);
+    test_sub_q16_16(0x00000000UL, 0x00000000UL, 0x00000000UL);
+    test_sub_q16_16(0x12345678UL, 0xFEDCBA98UL, 0x13579BE0UL);
+    test_sub_q16_16(0x00010000UL, 0x00030000UL, 0xFFFE0000UL);
+    test_mul_q16_16(0x00018000UL, 0x00020000UL, 0x00030000UL);
+    test_mul_q16_16(0x7FFF0000UL, 0x00020000UL, 0x7FFFFFFFUL);
+    test_mul_q16_16(0x80010000UL, 0x00020000UL, 0x80000000UL);
+    test_mul_q16_16(0xFFFF8000UL, 0x00008000UL, 0xFFFFC000UL);
+    test_mul_q16_16(0x00000001UL, 0x00008000UL, 0x00000001UL);
+    test_mul_q16_16(0x00030000UL, 0x00020000UL, 0x00060000UL);
+    test_mul_q16_16(0x00000000UL, 0x00000000UL, 0x00000000UL);
+    test_mul_q16_16(0x12345678UL, 0xFEDCBA98UL, 0x80000000UL);
+    test_mul_q16_16(0x00010000UL, 0x00030000UL, 0x00030000UL);
+    test_div_q16_16(0x00018000UL, 0x00020000UL, 0x0000C000UL);
+    test_div_q16_16(0x7FFF0000UL, 0x00020000UL, 0x3FFF8000UL);
+    test_div_q16_16(0x80010000UL, 0x00020000UL, 0xC0008000UL);
+    test_div_q16_16(0xFFFF8000UL, 0x00008000UL, 0xFFFF0000UL);
+    test_div_q16_16(0x00000001UL, 0x00008000UL, 0x00000002UL);
+    test_div_q16_16(0x00030000UL, 0x00020000UL, 0x00018000UL);
+    test_div_q16_16(0x00000000UL, 0x00000000UL, 0x7FFFFFFFUL);
+    test_div_q16_16(0x12345678UL, 0xFEDCBA98UL, 0xFFF00000UL);
+    test_div_q16_16(0x00010000UL, 0x00030000UL, 0x00005555UL);
+
+    /* Halt -- results readable at 0x0200 */
+    __asm__ volatile("hlt");
+    return 0;
+}
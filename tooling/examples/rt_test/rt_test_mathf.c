@@ -0,0 +1,191 @@
+/*
+ * Single-precision libm core unit tests for i8085
+ *
+ * Tests sqrtf, expf, logf, sinf, cosf, atan2f from builtins/mathf.S.
+ *
+ * Expected values are the correctly rounded results (computed on the
+ * host in double precision).  sqrtf must match exactly; the others
+ * are allowed 1 ulp.  Special operands follow C99 Annex F, with the
+ * softfp conventions: subnormal inputs count as zero and NaN results
+ * are compared as "any NaN".
+ */
+
+#include "rt_test.h"
+
+float sqrtf(float);
+float expf(float);
+float logf(float);
+float sinf(float);
+float cosf(float);
+float atan2f(float, float);
+
+/* Volatile operands prevent constant folding */
+static volatile float vfa, vfb;
+
+/* Distance in ulps between two finite floats of the same sign */
+static uint32_t ulp_diff(uint32_t a, uint32_t b) {
+    if ((a ^ b) & 0x80000000UL)
+        return 0xFFFFFFFFUL;
+    return a > b ? a - b : b - a;
+}
+
+static void check_ulp(float r, uint32_t expected, uint32_t tol) {
+    if (compareResultF(r, expected) == 0)
+        test_pass();
+    else if (ulp_diff(toRep32(r), expected) <= tol)
+        test_pass();
+    else
+        test_fail();
+}
+
+static void test_sqrtf(uint32_t a, uint32_t expected) {
+    vfa = fromRep32(a);
+    CHECK_FLOAT(sqrtf(vfa), expected);
+}
+
+static void test_expf(uint32_t a, uint32_t expected) {
+    vfa = fromRep32(a);
+    check_ulp(expf(vfa), expected, 1);
+}
+
+static void test_logf(uint32_t a, uint32_t expected) {
+    vfa = fromRep32(a);
+    check_ulp(logf(vfa), expected, 1);
+}
+
+static void test_sinf(uint32_t a, uint32_t expected) {
+    vfa = fromRep32(a);
+    check_ulp(sinf(vfa), expected, 1);
+}
+
+static void test_cosf(uint32_t a, uint32_t expected) {
+    vfa = fromRep32(a);
+    check_ulp(cosf(vfa), expected, 1);
+}
+
+static void test_atan2(uint32_t y, uint32_t x, uint32_t expected) {
+    vfa = fromRep32(y); vfb = fromRep32(x);
+    check_ulp(atan2f(vfa, vfb), expected, 1);
+}
+
+int main(void) {
+    test_init();
+
+    /* ============ sqrtf (correctly rounded) ============ */
+    test_sqrtf(0x40800000UL, 0x40000000UL);  /* 4 -> 2 */
+    test_sqrtf(0x40000000UL, 0x3FB504F3UL);  /* 2 -> 1.41421354 */
+    test_sqrtf(0x3F800000UL, 0x3F800000UL);  /* 1 -> 1 */
+    test_sqrtf(0x3E800000UL, 0x3F000000UL);  /* 0.25 -> 0.5 */
+    test_sqrtf(0x41C80000UL, 0x40A00000UL);  /* 25 -> 5 */
+    test_sqrtf(0x4479C000UL, 0x41FCDB0FUL);  /* 999 -> 31.6069622 */
+    test_sqrtf(0x3A83126FUL, 0x3D0186E3UL);  /* 0.001 -> 0.0316227786 */
+    test_sqrtf(0x7F7FFFFFUL, 0x5F7FFFFFUL);  /* FLT_MAX */
+    test_sqrtf(0x00800000UL, 0x20000000UL);  /* FLT_MIN */
+    test_sqrtf(0x3F000000UL, 0x3F3504F3UL);  /* 0.5 -> 0.707106769 */
+    test_sqrtf(0x4B000001UL, 0x453504F4UL);  /* 8388609 -> 2896.30957 */
+    test_sqrtf(0x40490FDBUL, 0x3FE2DFC5UL);  /* pi -> 1.7724539 */
+    test_sqrtf(0x00000000UL, 0x00000000UL);  /* +0 */
+    test_sqrtf(0x80000000UL, 0x80000000UL);  /* -0 -> -0 */
+    test_sqrtf(0x7F800000UL, 0x7F800000UL);  /* +Inf */
+    test_sqrtf(0xBF800000UL, 0x7FC00000UL);  /* -1 -> NaN */
+    test_sqrtf(0xFF800000UL, 0x7FC00000UL);  /* -Inf -> NaN */
+    test_sqrtf(0x7FC00000UL, 0x7FC00000UL);  /* NaN */
+
+    /* ============ expf ============ */
+    test_expf(0x3F800000UL, 0x402DF854UL);   /* 1 -> e */
+    test_expf(0xBF800000UL, 0x3EBC5AB2UL);   /* -1 -> 0.36787945 */
+    test_expf(0x3F000000UL, 0x3FD3094CUL);   /* 0.5 -> 1.64872122 */
+    test_expf(0x40200000UL, 0x4142EB7FUL);   /* 2.5 -> 12.1824942 */
+    test_expf(0x41200000UL, 0x46AC14EEUL);   /* 10 -> 22026.4648 */
+    test_expf(0xC1200000UL, 0x383E6BCEUL);   /* -10 -> 4.5399931e-05 */
+    test_expf(0x42B00000UL, 0x7EF882B7UL);   /* 88 -> 1.65163627e+38 */
+    test_expf(0xC2AE0000UL, 0x00B33687UL);   /* -87 -> 1.64581145e-38 */
+    test_expf(0x3A83126FUL, 0x3F8020C9UL);   /* 0.001 -> 1.00100052 */
+    test_expf(0xBD4CCCCDUL, 0x3F7383C6UL);   /* -0.05 -> 0.951229453 */
+    test_expf(0x3E99999AUL, 0x3FACC82DUL);   /* 0.3 -> 1.34985888 */
+    test_expf(0x42B17217UL, 0x7F7FFF84UL);   /* 88.7228317 -> 3.40279852e+38 */
+    test_expf(0x42B20000UL, 0x7F800000UL);   /* 89 -> +Inf */
+    test_expf(0xC2D00000UL, 0x00000000UL);   /* -104 -> 0 */
+    test_expf(0x00000000UL, 0x3F800000UL);   /* 0 -> 1 */
+    test_expf(0x7F800000UL, 0x7F800000UL);   /* +Inf */
+    test_expf(0xFF800000UL, 0x00000000UL);   /* -Inf -> 0 */
+    test_expf(0x7FC00000UL, 0x7FC00000UL);   /* NaN */
+
+    /* ============ logf ============ */
+    test_logf(0x40000000UL, 0x3F317218UL);   /* 2 -> ln2 */
+    test_logf(0x402DF854UL, 0x3F7FFFFFUL);   /* (float)e -> 0.99999994 */
+    test_logf(0x41200000UL, 0x40135D8EUL);   /* 10 -> 2.30258512 */
+    test_logf(0x3F000000UL, 0xBF317218UL);   /* 0.5 -> -ln2 */
+    test_logf(0x3F8CCCCDUL, 0x3DC331FFUL);   /* 1.1 -> 0.0953102037 */
+    test_logf(0x3F7AE148UL, 0xBCA5801BUL);   /* 0.98 -> -0.020202687 */
+    test_logf(0x3A83126FUL, 0xC0DD0C55UL);   /* 0.001 -> -6.90775537 */
+    test_logf(0x7F7FFFFFUL, 0x42B17218UL);   /* FLT_MAX -> 88.7228394 */
+    test_logf(0x00800000UL, 0xC2AEAC50UL);   /* FLT_MIN -> -87.3365479 */
+    test_logf(0x3F800001UL, 0x33FFFFFFUL);   /* 1 + ulp -> 1.19209282e-07 */
+    test_logf(0x3F7FFFFFUL, 0xB3800000UL);   /* 1 - ulp/2 -> -5.96046448e-08 */
+    test_logf(0x447A0000UL, 0x40DD0C55UL);   /* 1000 -> 6.90775537 */
+    test_logf(0x3F800000UL, 0x00000000UL);   /* 1 -> +0 */
+    test_logf(0x00000000UL, 0xFF800000UL);   /* 0 -> -Inf */
+    test_logf(0xBF800000UL, 0x7FC00000UL);   /* -1 -> NaN */
+    test_logf(0x7F800000UL, 0x7F800000UL);   /* +Inf */
+    test_logf(0x7FC00000UL, 0x7FC00000UL);   /* NaN */
+
+    /* ============ sinf ============ */
+    test_sinf(0x3F800000UL, 0x3F576AA4UL);   /* 1 -> 0.841470957 */
+    test_sinf(0xBF800000UL, 0xBF576AA4UL);   /* -1 */
+    test_sinf(0x3F490FDBUL, 0x3F3504F3UL);   /* pi/4 */
+    test_sinf(0x3FC90FDBUL, 0x3F800000UL);   /* pi/2 -> 1 */
+    test_sinf(0x40490FDBUL, 0xB3BBBD2EUL);   /* (float)pi -> -8.74227766e-08 */
+    test_sinf(0x40C90FDBUL, 0x343BBD2EUL);   /* (float)2pi -> 1.74845553e-07 */
+    test_sinf(0x40A00000UL, 0xBF757C10UL);   /* 5 -> -0.958924294 */
+    test_sinf(0xC1200000UL, 0x3F0B44F8UL);   /* -10 -> 0.54402113 */
+    test_sinf(0x42C80000UL, 0xBF01A12EUL);   /* 100 -> -0.506365657 */
+    test_sinf(0x447A0000UL, 0x3F53AE61UL);   /* 1000 -> 0.826879561 */
+    test_sinf(0x4B800000UL, 0xBF47917CUL);   /* 2^24 -> -0.779563665 */
+    test_sinf(0x6F79BE45UL, 0x3F800000UL);   /* 7.7e28 -> 1 */
+    test_sinf(0x3C23D70AUL, 0x3C23D657UL);   /* 0.01 -> 0.00999983307 */
+    test_sinf(0x80000000UL, 0x80000000UL);   /* -0 -> -0 */
+    test_sinf(0x7F800000UL, 0x7FC00000UL);   /* +Inf -> NaN */
+
+    /* ============ cosf ============ */
+    test_cosf(0x3F800000UL, 0x3F0A5140UL);   /* 1 -> 0.540302277 */
+    test_cosf(0xBF800000UL, 0x3F0A5140UL);   /* -1 */
+    test_cosf(0x3F490FDBUL, 0x3F3504F3UL);   /* pi/4 */
+    test_cosf(0x3FC90FDBUL, 0xB33BBD2EUL);   /* (float)pi/2 -> -4.37113883e-08 */
+    test_cosf(0x40490FDBUL, 0xBF800000UL);   /* pi -> -1 */
+    test_cosf(0x40A00000UL, 0x3E913C2CUL);   /* 5 -> 0.2836622 */
+    test_cosf(0xC1200000UL, 0xBF56CD64UL);   /* -10 -> -0.839071512 */
+    test_cosf(0x42C80000UL, 0x3F5CC0EEUL);   /* 100 -> 0.862318873 */
+    test_cosf(0x447A0000UL, 0x3F0FF813UL);   /* 1000 -> 0.562379062 */
+    test_cosf(0x4B800000UL, 0x3F2056B4UL);   /* 2^24 -> 0.626322985 */
+    test_cosf(0x6F79BE45UL, 0xB0DDEEA9UL);   /* 7.7e28 -> -1.61476976e-09 */
+    test_cosf(0x3C23D70AUL, 0x3F7FFCB9UL);   /* 0.01 -> 0.999949992 */
+    test_cosf(0x00000000UL, 0x3F800000UL);   /* 0 -> 1 */
+    test_cosf(0xFF800000UL, 0x7FC00000UL);   /* -Inf -> NaN */
+
+    /* ============ atan2f ============ */
+    test_atan2(0x3F800000UL, 0x3F800000UL, 0x3F490FDBUL);  /* (1, 1) -> pi/4 */
+    test_atan2(0x3F800000UL, 0xBF800000UL, 0x4016CBE4UL);  /* (1, -1) -> 3pi/4 */
+    test_atan2(0xBF800000UL, 0xBF800000UL, 0xC016CBE4UL);  /* (-1, -1) -> -3pi/4 */
+    test_atan2(0x3F800000UL, 0x40000000UL, 0x3EED6338UL);  /* (1, 2) -> 0.463647604 */
+    test_atan2(0x40000000UL, 0x3F800000UL, 0x3F8DB70DUL);  /* (2, 1) -> 1.10714877 */
+    test_atan2(0x3DCCCCCDUL, 0x41200000UL, 0x3C23D5A5UL);  /* (0.1, 10) -> 0.00999966729 */
+    test_atan2(0xC1200000UL, 0x3DCCCCCDUL, 0xBFC7C82FUL);  /* (-10, 0.1) -> -1.56079662 */
+    test_atan2(0x3F000000UL, 0xBF400000UL, 0x40236E05UL);  /* (0.5, -0.75) -> 2.55359006 */
+    test_atan2(0x3F400000UL, 0x3F000000UL, 0x3F7B985FUL);  /* (0.75, 0.5) -> 0.982793748 */
+    test_atan2(0x33D6BF95UL, 0x3F800000UL, 0x33D6BF95UL);  /* (1e-7, 1) -> 1e-7 */
+    test_atan2(0x40400000UL, 0x40800000UL, 0x3F24BC7DUL);  /* (3, 4) -> 0.643501103 */
+    test_atan2(0x00000000UL, 0xBF800000UL, 0x40490FDBUL);  /* (+0, -1) -> pi */
+    test_atan2(0x80000000UL, 0xBF800000UL, 0xC0490FDBUL);  /* (-0, -1) -> -pi */
+    test_atan2(0x80000000UL, 0x3F800000UL, 0x80000000UL);  /* (-0, 1) -> -0 */
+    test_atan2(0x3F800000UL, 0x00000000UL, 0x3FC90FDBUL);  /* (1, 0) -> pi/2 */
+    test_atan2(0x7F800000UL, 0x7F800000UL, 0x3F490FDBUL);  /* (Inf, Inf) -> pi/4 */
+    test_atan2(0xFF800000UL, 0xFF800000UL, 0xC016CBE4UL);  /* (-Inf, -Inf) -> -3pi/4 */
+    test_atan2(0x3F800000UL, 0xFF800000UL, 0x40490FDBUL);  /* (1, -Inf) -> pi */
+    test_atan2(0xBF800000UL, 0x7F800000UL, 0x80000000UL);  /* (-1, Inf) -> -0 */
+    test_atan2(0x7FC00000UL, 0x3F800000UL, 0x7FC00000UL);  /* NaN */
+
+    /* Halt -- results readable at 0x0200 */
+    __asm__ volatile("hlt");
+    return 0;
+}
@@ -0,0 +1,148 @@
+/*
+ * Integer <-> decimal conversion unit tests for i8085
+ *
+ * Tests builtins/numconv.S: utoa/itoa/ultoa/ltoa in base 10 (packed
+ * BCD path) and the generic-radix fallback, atoi/atol, and the
+ * least-significant-first __ultoa_invert10 used by tinystdio.
+ */
+
+#include "rt_test.h"
+
+char *utoa(unsigned, char *, int);
+char *itoa(int, char *, int);
+char *ultoa(unsigned long, char *, int);
+char *ltoa(long, char *, int);
+int atoi(const char *);
+long atol(const char *);
+char *__ultoa_invert10(unsigned long, char *);
+
+/* Volatile operands prevent constant folding */
+static volatile uint16_t v16;
+static volatile uint32_t v32;
+static volatile int vbase;
+static char buf[40];
+
+static int same(const char *a, const char *b) {
+    while (*a && *a == *b) { a++; b++; }
+    return *a == *b;
+}
+
+static void test_utoa(uint16_t v, int base, const char *expected) {
+    v16 = v; vbase = base;
+    CHECK(utoa(v16, buf, vbase) == buf && same(buf, expected));
+}
+
+static void test_itoa(int16_t v, int base, const char *expected) {
+    v16 = (uint16_t)v; vbase = base;
+    CHECK(itoa((int16_t)v16, buf, vbase) == buf && same(buf, expected));
+}
+
+static void test_ultoa(uint32_t v, int base, const char *expected) {
+    v32 = v; vbase = base;
+    CHECK(ultoa(v32, buf, vbase) == buf && same(buf, expected));
+}
+
+static void test_ltoa(int32_t v, int base, const char *expected) {
+    v32 = (uint32_t)v; vbase = base;
+    CHECK(ltoa((int32_t)v32, buf, vbase) == buf && same(buf, expected));
+}
+
+static void test_bad_base(int base) {
+    vbase = base;
+    buf[0] = 'x';
+    CHECK(utoa(123, buf, vbase) == 0 && buf[0] == '\0');
+    buf[0] = 'x';
+    CHECK(ultoa(123, buf, vbase) == 0 && buf[0] == '\0');
+}
+
+static void test_atol(const char *s, int32_t expected) {
+    CHECK(atol(s) == expected);
+    CHECK(atoi(s) == (int16_t)expected);
+}
+
+/* expected is written most significant digit first */
+static void test_invert(uint32_t v, const char *expected) {
+    const char *e = expected;
+    char *end, *p;
+    int ok = 1;
+    v32 = v;
+    end = __ultoa_invert10(v32, buf);
+    while (*e) e++;
+    for (p = buf; p < end; p++)
+        if (e == expected || *p != *--e) ok = 0;
+    CHECK(ok && e == expected);
+}
+
+int main(void) {
+    test_init();
+
+    /* ============ Base 10 ============ */
+    test_utoa(0, 10, "0");
+    test_utoa(7, 10, "7");
+    test_utoa(10, 10, "10");
+    test_utoa(255, 10, "255");
+    test_utoa(256, 10, "256");
+    test_utoa(9999, 10, "9999");
+    test_utoa(10000, 10, "10000");
+    test_utoa(65535, 10, "65535");
+    test_itoa(-1, 10, "-1");
+    test_itoa(-32768, 10, "-32768");
+    test_itoa(32767, 10, "32767");
+    test_ultoa(0, 10, "0");
+    test_ultoa(65535, 10, "65535");
+    test_ultoa(65536, 10, "65536");
+    test_ultoa(999999, 10, "999999");
+    test_ultoa(1000000, 10, "1000000");
+    test_ultoa(16777215UL, 10, "16777215");
+    test_ultoa(99999999UL, 10, "99999999");
+    test_ultoa(100000000UL, 10, "100000000");
+    test_ultoa(1234567890UL, 10, "1234567890");
+    test_ultoa(4294967295UL, 10, "4294967295");
+    test_ltoa(-1L, 10, "-1");
+    test_ltoa(-2147483647L - 1, 10, "-2147483648");
+    test_ltoa(2147483647L, 10, "2147483647");
+    test_ltoa(-100000L, 10, "-100000");
+
+    /* ============ Other bases ============ */
+    test_utoa(0, 16, "0");
+    test_utoa(0xBEEF, 16, "beef");
+    test_utoa(5, 2, "101");
+    test_utoa(65535, 36, "1ekf");
+    test_itoa(-1, 16, "ffff");
+    test_ultoa(0xDEADBEEFUL, 16, "deadbeef");
+    test_ultoa(4294967295UL, 8, "37777777777");
+    test_ultoa(4294967295UL, 36, "1z141z3");
+    test_ltoa(-1L, 2, "11111111111111111111111111111111");
+    test_bad_base(0);
+    test_bad_base(1);
+    test_bad_base(37);
+    test_bad_base(-10);
+    test_bad_base(266);
+
+    /* ============ atoi / atol ============ */
+    test_atol("0", 0);
+    test_atol("42", 42);
+    test_atol("  \t-17x", -17);
+    test_atol("+6399", 6399);
+    test_atol("6400", 6400);
+    test_atol("65535", 65535L);
+    test_atol("123456789", 123456789L);
+    test_atol("-2147483648", -2147483647L - 1);
+    test_atol("4294967295", -1L);
+    test_atol("\n\v\f\r 0009", 9);
+    test_atol("abc", 0);
+    test_atol("- 5", 0);
+    test_atol("", 0);
+
+    /* ============ __ultoa_invert10 ============ */
+    test_invert(0, "0");
+    test_invert(10, "10");
+    test_invert(65535, "65535");
+    test_invert(100000, "100000");
+    test_invert(1000000, "1000000");
+    test_invert(4294967295UL, "4294967295");
+
+    /* Halt -- results readable at 0x0200 */
+    __asm__ volatile("hlt");
+    return 0;
+}
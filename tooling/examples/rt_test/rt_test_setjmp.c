@@ -0,0 +1,124 @@
+/*
+ * setjmp/longjmp and SJLJ exception unit tests for i8085
+ *
+ * Tests builtins/setjmp.S: setjmp returning 0 then the longjmp value,
+ * longjmp(env, 0) returning 1, jumps out of nested calls with the stack
+ * restored, and exc_throw unwinding the __exc_top frame chain (nested
+ * try frames, rethrow from a handler).
+ */
+
+#include <setjmp.h>
+#include <i8085/except.h>
+
+#include "rt_test.h"
+
+static jmp_buf jb;
+static volatile int depth_reached;
+
+__attribute__((noinline)) static int dive(int n, int val) {
+    volatile uint8_t pad[8];
+    pad[0] = (uint8_t)n;
+    depth_reached = n;
+    if (n == 0)
+        longjmp(jb, val);
+    return dive(n - 1, val) + pad[0];
+}
+
+/* Address of a local one call deep: tracks the caller's SP. */
+__attribute__((noinline)) static uintptr_t stack_mark(void) {
+    volatile uint8_t x = 0;
+    return (uintptr_t)&x;
+}
+
+__attribute__((noinline)) static int thrower(int n, int code) {
+    if (n == 0)
+        exc_throw(code);
+    return thrower(n - 1, code) + 1;
+}
+
+/* One try block around thrower(n) (n < 0: no call); returns the code
+   thrown, or 0. */
+__attribute__((noinline)) static int try_throw(int n, int code) {
+    exc_frame_t f;
+    int r;
+    f.prev = __exc_top;
+    __exc_top = &f;
+    if ((r = setjmp(f.env)) == 0) {
+        if (n >= 0)
+            thrower(n, code);
+        __exc_top = f.prev;
+    }
+    return r;
+}
+
+/* Handler rethrows code + 1 to the enclosing frame. */
+__attribute__((noinline)) static int try_rethrow(int code) {
+    exc_frame_t f;
+    int r;
+    f.prev = __exc_top;
+    __exc_top = &f;
+    if ((r = setjmp(f.env)) == 0) {
+        thrower(3, code);
+        __exc_top = f.prev;
+        return 0;
+    }
+    exc_throw(r + 1);
+}
+
+int main(void) {
+    volatile int calls;
+    uintptr_t mark;
+    int r;
+
+    test_init();
+
+    /* ============ setjmp / longjmp ============ */
+    calls = 0;
+    r = setjmp(jb);
+    calls++;
+    if (r == 0)
+        longjmp(jb, 42);
+    CHECK(r == 42 && calls == 2);
+
+    calls = 0;
+    r = setjmp(jb);
+    calls++;
+    if (r == 0)
+        longjmp(jb, 0);
+    CHECK(r == 1 && calls == 2);
+
+    r = setjmp(jb);
+    if (r == 0)
+        dive(10, -7);
+    CHECK(r == -7 && depth_reached == 0);
+
+    /* SP is back where setjmp left it after a deep jump */
+    mark = stack_mark();
+    r = setjmp(jb);
+    if (r == 0)
+        dive(20, 0x1234);
+    CHECK(r == 0x1234 && stack_mark() == mark);
+
+    /* ============ exc_throw ============ */
+    CHECK(__exc_top == 0);
+    CHECK(try_throw(5, 9) == 9 && __exc_top == 0);
+    CHECK(try_throw(0, 0) == 1 && __exc_top == 0);
+    CHECK(try_throw(-1, 3) == 0 && __exc_top == 0);
+
+    {
+        exc_frame_t outer;
+        outer.prev = __exc_top;
+        __exc_top = &outer;
+        if ((r = setjmp(outer.env)) == 0) {
+            /* Inner frame catches and unlinks itself */
+            CHECK(try_throw(4, 100) == 100 && __exc_top == &outer);
+            try_rethrow(200);
+            CHECK(0);
+        }
+        CHECK(r == 201 && __exc_top == 0);
+    }
+
+    /* Halt -- results readable at 0x0200 */
+    __asm__ volatile("hlt");
+    return 0;
+}
@@ -41,6 +41,12 @@ TESTS=(
     rt_test_float_arith
     rt_test_float_conv
     rt_test_arith64
+    rt_test_mathf
+    rt_test_fixmath
+    rt_test_numconv
+    rt_test_crc
+    rt_test_setjmp
+    rt_test_bitops
 )
 
 # Max simulator steps per test
@@ -50,6 +56,12 @@ MAX_STEPS[rt_test_divsi3]=50000000
 MAX_STEPS[rt_test_float_arith]=20000000
 MAX_STEPS[rt_test_float_conv]=20000000
 MAX_STEPS[rt_test_arith64]=100000000
+MAX_STEPS[rt_test_mathf]=50000000
+MAX_STEPS[rt_test_fixmath]=20000000
+MAX_STEPS[rt_test_numconv]=20000000
+MAX_STEPS[rt_test_crc]=20000000
+MAX_STEPS[rt_test_setjmp]=2000000
+MAX_STEPS[rt_test_bitops]=20000000
 
 BUILDDIR="${SCRIPT_DIR}/build/${OPT}"
 mkdir -p "${BUILDDIR}"
@@ -82,7 +94,8 @@ for test in "${TESTS[@]}"; do
 
     # Compile
     if ! "${CLANG}" --target=i8085-unknown-elf -ffreestanding -fno-builtin "-${OPT}" \
-        -I"${SCRIPT_DIR}" -c "${src}" -o "${BUILDDIR}/${test}.o" 2>/dev/null; then
+        -I"${SCRIPT_DIR}" -isystem "${ROOT}/sysroot/include" \
+        -c "${src}" -o "${BUILDDIR}/${test}.o" 2>/dev/null; then
         printf "%-25s %6s %6s %6s  %8s  %s\n" "${test}" "-" "-" "-" "CC_ERR" "-"
         all_ok=false
         continue
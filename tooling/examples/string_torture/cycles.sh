@@ -0,0 +1,74 @@
+#!/usr/bin/env bash
+# Cycles per byte for each string function: builtins/stringops.S
+# (libgcc.a first, the normal link order) against picolibc's C version
+# (libc.a first).
+#
+# Each function is built twice with string_torture.c -DBENCH_FN=<n>, at
+# BENCH_LEN=16 and BENCH_LEN=272; the clock difference divided by
+# 256 * BENCH_REPS removes the call and setup overhead.
+#
+# Usage: cycles.sh [-O2|-Oz|...]   (default -Oz)
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")/../../.." && pwd)"
+TOOLCHAIN="${ROOT}/llvm-project/build-clang-8085/bin"
+
+CLANG="${CLANG:-${TOOLCHAIN}/clang}"
+LLD="${LLD:-${TOOLCHAIN}/ld.lld}"
+OBJCOPY="${LLVM_OBJCOPY:-${TOOLCHAIN}/llvm-objcopy}"
+TRACE="${TRACE:-$ROOT/i8085-trace/build/i8085-trace}"
+
+CRT="${CRT:-$ROOT/sysroot/crt/crt0.S}"
+LIBGCC="${LIBGCC:-$ROOT/sysroot/lib/libgcc.a}"
+LIBC="${LIBC:-$ROOT/sysroot/lib/libc.a}"
+LINKER="$ROOT/sysroot/ldscripts/i8085-32kram-32krom.ld"
+CLANG_EXTRA="${CLANG_EXTRA:-}"
+
+OPT="${1:--Oz}"
+SRC="${ROOT}/tooling/examples/string_torture/string_torture.c"
+OUT="${ROOT}/tooling/examples/string_torture/build/cycles"
+FUNCS=(strlen strnlen strcmp strncmp strcpy strcat strncpy strchr strrchr)
+SHORT=16
+LONG=272
+REPS=4
+
+for tool in "${CLANG}" "${LLD}" "${OBJCOPY}" "${TRACE}"; do
+  if [[ ! -x "${tool}" ]]; then
+    echo "Error: missing tool ${tool}" >&2
+    exit 1
+  fi
+done
+
+mkdir -p "${OUT}"
+# shellcheck disable=SC2086
+"${CLANG}" --target=i8085-unknown-elf -ffreestanding -fno-builtin ${OPT} \
+  ${CLANG_EXTRA} -c "${CRT}" -o "${OUT}/crt0.o"
+
+# clocks <fn index> <len> <asm|c>
+clocks() {
+  local tag="$1_$2_$3"
+  # shellcheck disable=SC2086
+  "${CLANG}" --target=i8085-unknown-elf -ffreestanding -fno-builtin ${OPT} \
+    ${CLANG_EXTRA} -DBENCH_FN="$1" -DBENCH_LEN="$2" -DBENCH_REPS="${REPS}" \
+    -c "${SRC}" -o "${OUT}/${tag}.o"
+  local libs=("${LIBGCC}" "${LIBC}" "${LIBGCC}")
+  if [[ "$3" == "c" ]]; then
+    libs=("${LIBC}" "${LIBGCC}" "${LIBC}")
+  fi
+  "${LLD}" -m i8085elf --gc-sections -T "${LINKER}" \
+    -o "${OUT}/${tag}.elf" "${OUT}/crt0.o" "${OUT}/${tag}.o" "${libs[@]}"
+  "${OBJCOPY}" -O binary "${OUT}/${tag}.elf" "${OUT}/${tag}.bin"
+  "${TRACE}" -e 0x0000 -l 0x0000 -n 5000000 -S -q "${OUT}/${tag}.bin" 2>/dev/null |
+    grep -o '"clk":[0-9]*' | cut -d: -f2
+}
+
+printf "%-8s %10s %10s %8s\n" "function" "asm c/B" "picolibc" "speedup"
+for i in "${!FUNCS[@]}"; do
+  a0="$(clocks "$i" "${SHORT}" asm)"
+  a1="$(clocks "$i" "${LONG}" asm)"
+  c0="$(clocks "$i" "${SHORT}" c)"
+  c1="$(clocks "$i" "${LONG}" c)"
+  awk -v f="${FUNCS[$i]}" -v a="$((a1 - a0))" -v c="$((c1 - c0))" \
+    -v n="$(((LONG - SHORT) * REPS))" \
+    'BEGIN { printf "%-8s %10.1f %10.1f %7.2fx\n", f, a / n, c / n, (a > 0 ? c / a : 0) }'
+done
@@ -1,7 +1,14 @@
 /*
  * String operations torture test for i8085.
  *
- * Exercises hand-written strlen and strcmp with various inputs.
+ * Exercises the hand-written builtins/stringops.S functions (strlen,
+ * strnlen, strcmp, strncmp, strcpy, strcat, strncpy, strchr, strrchr)
+ * with various inputs.
+ *
+ * Built with -DBENCH_FN=<n> -DBENCH_LEN=<len> it instead runs one
+ * function BENCH_REPS times over a BENCH_LEN-byte string and halts;
+ * cycles.sh turns two such runs into cycles per byte, for both our
+ * version and picolibc's C version.
  *
  * Input layout (32 bytes at 0x0100):
  *   +0:  "Hello"   (len 5)
@@ -16,16 +23,23 @@
 
 #include <stdint.h>
 
-/* Declare strlen/strcmp directly — clang's freestanding <string.h>
-   only provides memcpy/memset/memmove/memcmp as builtins. */
+/* Declare the string functions directly — clang's freestanding
+   <string.h> only provides memcpy/memset/memmove/memcmp as builtins. */
 typedef unsigned int size_t;
 size_t strlen(const char *s);
+size_t strnlen(const char *s, size_t maxlen);
 int strcmp(const char *s1, const char *s2);
+int strncmp(const char *s1, const char *s2, size_t n);
+char *strcpy(char *dst, const char *src);
+char *strcat(char *dst, const char *src);
+char *strncpy(char *dst, const char *src, size_t n);
+char *strchr(const char *s, int c);
+char *strrchr(const char *s, int c);
 
 #define INPUT_ADDR  0x0100
 #define OUTPUT_ADDR 0x0200
 
-#define TOTAL_TESTS 12
+#define TOTAL_TESTS 29
 
 __attribute__((noinline)) static void halt_ok(void) { __asm__ volatile("hlt"); }
 __attribute__((noinline)) static void fail_loop(void) {
@@ -33,6 +47,57 @@ __attribute__((noinline)) static void fail_loop(void) {
     }
 }
 
+#ifdef BENCH_FN
+
+#ifndef BENCH_REPS
+#define BENCH_REPS 4
+#endif
+
+/* 0 strlen, 1 strnlen, 2 strcmp, 3 strncmp, 4 strcpy, 5 strcat,
+   6 strncpy, 7 strchr, 8 strrchr */
+static char bench_a[BENCH_LEN + 1];
+static char bench_b[BENCH_LEN + 1];
+static char bench_dst[BENCH_LEN + 1];
+
+int main(void) {
+    volatile uint16_t *output = (volatile uint16_t *)OUTPUT_ADDR;
+    volatile uint16_t sink = 0;
+    uint16_t i;
+
+    for (i = 0; i < BENCH_LEN; i++)
+        bench_a[i] = bench_b[i] = 'a' + (i % 23);
+    if (BENCH_LEN)
+        bench_a[BENCH_LEN - 1] = '~'; /* strchr/strrchr target */
+
+    for (i = 0; i < BENCH_REPS; i++) {
+#if BENCH_FN == 0
+        sink += strlen(bench_a);
+#elif BENCH_FN == 1
+        sink += strnlen(bench_a, BENCH_LEN + 8);
+#elif BENCH_FN == 2
+        sink += strcmp(bench_b, bench_b);
+#elif BENCH_FN == 3
+        sink += strncmp(bench_b, bench_b, BENCH_LEN + 8);
+#elif BENCH_FN == 4
+        sink += (uint16_t)strcpy(bench_dst, bench_a);
+#elif BENCH_FN == 5
+        bench_dst[0] = 0;
+        sink += (uint16_t)strcat(bench_dst, bench_a);
+#elif BENCH_FN == 6
+        sink += (uint16_t)strncpy(bench_dst, bench_a, BENCH_LEN);
+#elif BENCH_FN == 7
+        sink += (uint16_t)strchr(bench_a, '~');
+#elif BENCH_FN == 8
+        sink += (uint16_t)strrchr(bench_a, 'a');
+#endif
+    }
+    *output = sink;
+    halt_ok();
+    return 0;
+}
+
+#else
+
 int main(void) {
     const char *hello1 = (const char *)(INPUT_ADDR + 0);   /* "Hello" */
     const char *hello2 = (const char *)(INPUT_ADDR + 6);   /* "Hello" */
@@ -92,6 +157,71 @@ int main(void) {
     /* 12. strcmp("", "") == 0 */
     if (strcmp(empty, empty) == 0) pass++;
 
+    /* ---- strnlen / strncmp ---- */
+
+    /* 13. strnlen("Hello", 3) == 3 */
+    if (strnlen(hello1, 3) == 3) pass++;
+
+    /* 14. strnlen("Hello", 10) == 5 */
+    if (strnlen(hello1, 10) == 5) pass++;
+
+    /* 15. strncmp("Hello", "Hellp", 4) == 0 */
+    if (strncmp(hello1, hellp, 4) == 0) pass++;
+
+    /* 16. strncmp("Hello", "Hellp", 5) < 0 */
+    if (strncmp(hello1, hellp, 5) < 0) pass++;
+
+    /* 17. strncmp("Hel", "Hello", 0) == 0 */
+    if (strncmp(hel, hello1, 0) == 0) pass++;
+
+    /* 18. strncmp("Hello", "Hel", 8) > 0 */
+    if (strncmp(hello1, hel, 8) > 0) pass++;
+
+    /* ---- strcpy / strcat / strncpy ---- */
+    {
+        char buf[16];
+
+        /* 19. strcpy returns dst and copies the terminator */
+        if (strcpy(buf, world) == buf && strcmp(buf, world) == 0) pass++;
+
+        /* 20. strcat("World!", "Hello") == "World!Hello" */
+        if (strcat(buf, hello1) == buf && strlen(buf) == 11 &&
+            buf[6] == 'H' && buf[10] == 'o') pass++;
+
+        /* 21. strncpy pads with NUL up to n and stops there */
+        buf[8] = 'x';
+        if (strncpy(buf, hel, 8) == buf && strcmp(buf, hel) == 0 &&
+            buf[3] == 0 && buf[7] == 0 && buf[8] == 'x') pass++;
+
+        /* 22. strncpy truncates without a terminator */
+        buf[3] = 'x';
+        if (strncpy(buf, world, 3) == buf && buf[0] == 'W' &&
+            buf[2] == 'r' && buf[3] == 'x') pass++;
+    }
+
+    /* ---- strchr / strrchr ---- */
+
+    /* 23. strchr("Hello", 'l') -> first 'l' */
+    if (strchr(hello1, 'l') == hello1 + 2) pass++;
+
+    /* 24. strchr("Hello", 'z') == NULL */
+    if (strchr(hello1, 'z') == 0) pass++;
+
+    /* 25. strchr("Hello", 0) -> terminator */
+    if (strchr(hello1, 0) == hello1 + 5) pass++;
+
+    /* 26. strrchr("Hello", 'l') -> last 'l' */
+    if (strrchr(hello1, 'l') == hello1 + 3) pass++;
+
+    /* 27. strrchr("World!", 'W') -> first char */
+    if (strrchr(world, 'W') == world) pass++;
+
+    /* 28. strrchr("", 'a') == NULL */
+    if (strrchr(empty, 'a') == 0) pass++;
+
+    /* 29. strrchr("Hello", 0) -> terminator */
+    if (strrchr(hello1, 0) == hello1 + 5) pass++;
+
     /* Write pass count to output */
     *output = (uint32_t)pass;
 
@@ -102,3 +232,5 @@ int main(void) {
     fail_loop();
     return 0;
 }
+
+#endif /* BENCH_FN */
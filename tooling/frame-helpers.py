@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""Replace inline frame setup in clang -S output with shared helpers.
+
+For -Oz builds: every function with a frame starts with
+    lxi h, -N / dad sp / sphl
+and returns through
+    lxi h, N / dad sp / sphl / ret
+This script rewrites, in place:
+  - the prologue of a function into `call __i8085_enter_N` (N = 7..32),
+    or into N/2 `push b` (+ `dcx sp`) for N <= 6
+  - each epilogue into `jmp __i8085_leave_N` (N = 7..32), or into N/2
+    `pop h` (+ `inx sp`) + `ret` for N <= 6
+The helpers live in builtins/frame.S (libgcc.a).  A prologue is only
+rewritten directly after the function label, where nothing is live yet.
+
+Usage: frame-helpers.py foo.s [bar.s ...]
+"""
+
+import re
+import sys
+
+HELPER_MIN, HELPER_MAX = 7, 32
+LABEL = re.compile(r"^([A-Za-z_.$][\w.$]*):")
+FUNC_TYPE = re.compile(r"^\s*\.type\s+([\w.$]+)\s*,\s*[@%]function", re.I)
+
+
+def code(line):
+    """Instruction text of a line, lowercased, without comments."""
+    text = re.split(r"\s*(?:;|//|#)", line, maxsplit=1)[0]
+    return " ".join(text.split()).lower()
+
+
+def imm16(text):
+    try:
+        return int(text, 0) & 0xFFFF
+    except ValueError:
+        return None
+
+
+def match_frame(lines, i, want_ret):
+    """Return (N signed, index after the sequence) or None.
+
+    Blank and comment-only lines may sit between the instructions; labels
+    may not (something could branch into the middle).
+    """
+    seq = []
+    j = i
+    need = 4 if want_ret else 3
+    while j < len(lines) and len(seq) < need:
+        c = code(lines[j])
+        if LABEL.match(c) or c.startswith("."):
+            return None
+        if c:
+            seq.append(c)
+        j += 1
+    if len(seq) < need:
+        return None
+    m = re.match(r"lxi\s+h\s*,\s*(\S+)$", seq[0])
+    if not m or seq[1] != "dad sp" or seq[2] != "sphl":
+        return None
+    if want_ret and seq[3] != "ret":
+        return None
+    v = imm16(m.group(1))
+    if v is None:
+        return None
+    return (v - 0x10000 if v & 0x8000 else v), j
+
+
+def indent_of(line):
+    return re.match(r"^\s*", line).group(0) or "\t"
+
+
+def rewrite(lines):
+    out = []
+    funcs = set()
+    saved = 0
+    i = 0
+    while i < len(lines):
+        line = lines[i]
+        m = FUNC_TYPE.match(line)
+        if m:
+            funcs.add(m.group(1))
+        m = LABEL.match(line)
+        if m and m.group(1) in funcs:
+            out.append(line)
+            i += 1
+            while i < len(lines) and not code(lines[i]):
+                out.append(lines[i])
+                i += 1
+            hit = match_frame(lines, i, want_ret=False)
+            if hit and 1 <= -hit[0] <= HELPER_MAX:
+                n = -hit[0]
+                ind = indent_of(lines[i])
+                if n >= HELPER_MIN:
+                    out.append(f"{ind}call\t__i8085_enter_{n}\n")
+                    saved += 2
+                else:
+                    out.extend([f"{ind}push\tb\n"] * (n // 2))
+                    if n & 1:
+                        out.append(f"{ind}dcx\tsp\n")
+                    saved += 5 - (n // 2 + (n & 1))
+                i = hit[1]
+            continue
+        hit = match_frame(lines, i, want_ret=True)
+        if hit and 1 <= hit[0] <= HELPER_MAX:
+            n = hit[0]
+            ind = indent_of(line)
+            if n >= HELPER_MIN:
+                out.append(f"{ind}jmp\t__i8085_leave_{n}\n")
+                saved += 3
+            else:
+                if n & 1:
+                    out.append(f"{ind}inx\tsp\n")
+                out.extend([f"{ind}pop\th\n"] * (n // 2))
+                out.append(f"{ind}ret\n")
+                saved += 6 - (n // 2 + (n & 1) + 1)
+            i = hit[1]
+            continue
+        out.append(line)
+        i += 1
+    return out, saved
+
+
+def main() -> int:
+    if len(sys.argv) < 2:
+        print(__doc__, file=sys.stderr)
+        return 2
+    total = 0
+    for path in sys.argv[1:]:
+        with open(path) as f:
+            lines = f.readlines()
+        new, saved = rewrite(lines)
+        if new != lines:
+            with open(path, "w") as f:
+                f.writelines(new)
+        total += saved
+    print(f"frame helpers: {total} bytes saved", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+"""Measure FreeRTOS task stack use in the simulator and size the stacks.
+
+With INCLUDE_uxTaskGetStackHighWaterMark the kernel paints each task
+stack with 0xA5 when the task is created, and stacks grow down, so the
+bytes a task never touched are a run of 0xA5 at the low end.  This
+script finds the statically allocated stacks in the link map (.bss
+sections whose name matches --pattern, "Stack" by default; build with
+-fdata-sections, as the demos do), runs the program, dumps that memory at
+the end and counts the run.  The deepest point a task reached is the
+lowest SP it ever had, so this is the same figure as tracking SP per
+task, without instrumenting the simulator.
+
+It prints a table and writes a header with one define per stack:
+
+  #define STACK_SIZE_xRxStack  112
+
+sized as used + --margin, rounded up to --align.  Demos declare their
+stacks with configSTACK_DEPTH( xRxStack ), which picks these up when
+built with make STACK_SIZES=<header> (FreeRTOS/demos/Makefile).
+
+  freertos-stack-sizes.py BIN MAP -o stack_sizes.h \\
+      --sim i8085-trace --sim-arg=--timer=65:30720 --sim-arg=-n --sim-arg=2000000
+
+The run has to exercise the deep paths (interrupts nesting on top of the
+deepest call chain); the margin covers what it misses.  Stacks from the
+heap (xTaskCreate) are not in the map and are not measured.  Exits
+with 2 (header still written) when a stack has no paint left.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+FILL = 0xA5
+MAP_SECTION = re.compile(
+    r"^\s*([0-9a-fA-F]+)\s+[0-9a-fA-F]+\s+([0-9a-fA-F]+)\s+\d+\s+\S.*:\(\.bss\.([\w.$]+)\)\s*$")
+DUMP_LINE = re.compile(r"^\s*([0-9A-Fa-f]{4}):\s*([0-9A-Fa-f ]+?)\s*(?:\|.*)?$")
+
+
+def find_stacks(map_path, pattern):
+    stacks = {}
+    with open(map_path, "r", encoding="utf-8") as f:
+        for line in f:
+            m = MAP_SECTION.match(line)
+            if m and pattern.search(m.group(3)):
+                size = int(m.group(2), 16)
+                if size:
+                    stacks[m.group(3)] = (int(m.group(1), 16), size)
+    return stacks
+
+
+def parse_dump(text):
+    mem = {}
+    for line in text.splitlines():
+        m = DUMP_LINE.match(line)
+        if not m:
+            continue
+        addr = int(m.group(1), 16)
+        for i, byte in enumerate(m.group(2).split()):
+            mem[addr + i] = int(byte, 16)
+    return mem
+
+
+def run_sim(sim, sim_args, binary, lo, hi):
+    cmd = [sim] + sim_args + ["-q", "-d", f"0x{lo:04X}:{hi - lo}", binary]
+    result = subprocess.run(cmd, text=True, capture_output=True)
+    return result.stdout + result.stderr
+
+
+def unused_bytes(mem, base, size):
+    n = 0
+    while n < size and mem.get(base + n) == FILL:
+        n += 1
+    return n
+
+
+def round_up(value, align):
+    return (value + align - 1) // align * align
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("binary", help="program image run by the simulator")
+    parser.add_argument("map", help="ld.lld -Map file of the same link")
+    parser.add_argument("-o", "--output", help="header to write (default: table only)")
+    parser.add_argument("--sim", default=os.environ.get("I8085_SIM", "i8085-trace"),
+                        help="simulator (default: $I8085_SIM or i8085-trace)")
+    parser.add_argument("--sim-arg", dest="sim_args", action="append", default=[],
+                        help="extra simulator argument (repeatable)")
+    parser.add_argument("--dump", help="use this memory dump instead of running the simulator")
+    parser.add_argument("--pattern", default="Stack",
+                        help="regex for stack symbols in the map (default: Stack)")
+    parser.add_argument("--margin", type=int, default=32,
+                        help="bytes added to the measured use (default 32)")
+    parser.add_argument("--align", type=int, default=8,
+                        help="round sizes up to this (default 8)")
+    args = parser.parse_args()
+
+    stacks = find_stacks(args.map, re.compile(args.pattern))
+    if not stacks:
+        print(f"error: no .bss sections matching '{args.pattern}' in {args.map}",
+              file=sys.stderr)
+        return 1
+
+    if args.dump:
+        with open(args.dump, "r", encoding="utf-8") as f:
+            text = f.read()
+    else:
+        lo = min(base for base, _ in stacks.values())
+        hi = max(base + size for base, size in stacks.values())
+        text = run_sim(args.sim, args.sim_args, args.binary, lo, hi)
+    mem = parse_dump(text)
+
+    rows = []
+    status = 0
+    for name, (base, size) in sorted(stacks.items(), key=lambda kv: kv[1][0]):
+        if base not in mem:
+            print(f"error: {name} (0x{base:04X}) missing from the dump", file=sys.stderr)
+            return 1
+        used = size - unused_bytes(mem, base, size)
+        if used == size:
+            # No paint left: the task used it all or ran past the end
+            print(f"warning: {name}: no unused bytes left, keeping {size}",
+                  file=sys.stderr)
+            new = size
+            status = 2
+        elif used == 0:
+            print(f"warning: {name}: never used (task not created?), keeping {size}",
+                  file=sys.stderr)
+            new = size
+        else:
+            new = round_up(used + args.margin, args.align)
+        rows.append((name, size, used, new))
+
+    width = max(len(name) for name, *_ in rows)
+    table = [f"{'stack':<{width}}  {'size':>5}  {'used':>5}  {'new':>5}"]
+    table += [f"{name:<{width}}  {size:>5}  {used:>5}  {new:>5}"
+              for name, size, used, new in rows]
+    saved = sum(size - new for _, size, _, new in rows)
+    table.append(f"{'saved':<{width}}  {saved:>5}")
+    print("\n".join(table))
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as f:
+            f.write(f"/* Generated by tooling/freertos-stack-sizes.py from "
+                    f"{os.path.basename(args.binary)}\n"
+                    f" * (margin {args.margin}, align {args.align}); do not edit.\n *\n")
+            for line in table:
+                f.write(f" *   {line}\n".rstrip() + "\n")
+            f.write(" */\n\n")
+            for name, _, _, new in rows:
+                f.write(f"#define STACK_SIZE_{name:<{width}}  {new}\n")
+    return status
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+"""Check freertos-trace.py against a hand-made OUT log.
+
+freertos-trace-sample.log is written by hand, not recorded, since no
+simulator in this tree logs OUT writes yet.  It covers three tasks
+blocking, waking and being preempted, and the three kinds of tick:
+- no switch;
+- a switch to a task that has never run, so no exit event follows;
+- a switch back to a preempted task, with RST 7.5 taken after the
+  port's EI and before the tick's exit event.
+It also has RST 7.5 landing between an event code and its payload, and
+a write to an unrelated port.
+
+The check converts the log and compares the slices on each track and
+the summary with the values worked out by hand below.
+
+  freertos-trace-check.py [--log freertos-trace-sample.log]
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+CLOCK = 3072000
+
+# track name -> [(start cycle, cycles)]
+EXPECTED_SLICES = {
+    "A": [(200, 400), (1600, 400), (2450, 550)],
+    "B": [(2000, 450)],
+    "IDLE": [(600, 1000)],
+    "RST 5.5": [(1400, 100)],
+    # The last tick ends at its switch (2450): the 7.5 entry at 2480
+    # closes it and its late exit event at 2560 is dropped
+    "RST 6.5 (tick)": [(1000, 150), (1900, 100), (2400, 50)],
+    "RST 7.5": [(2480, 50), (2710, 50)],
+}
+
+# (track, event name, cycle)
+EXPECTED_INSTANTS = [
+    ("startup", "queue_create", 120),
+    ("A", "blocking_on_receive", 500),
+    ("RST 5.5", "queue_send_from_isr", 1450),
+    ("B", "queue_send", 2100),
+    ("B", "priority_inherit 3", 2700),
+    ("A", "queue_receive", 3000),
+]
+
+EXPECTED_SUMMARY = """\
+task               cycles
+A                    1350
+B                     450
+IDLE                 1000
+
+interrupt           count     mean      max
+RST 5.5                 1      100      100
+RST 6.5 (tick)          3      100      150
+RST 7.5                 2       50       50
+"""
+
+
+def cycles(us):
+    return round(us * CLOCK / 1e6)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--log", default=os.path.join(HERE, "freertos-trace-sample.log"),
+                        help="OUT log to convert (default: the sample)")
+    args = parser.parse_args()
+
+    result = subprocess.run(
+        [sys.executable, os.path.join(HERE, "freertos-trace.py"), args.log,
+         "--clock", str(CLOCK)],
+        capture_output=True, text=True, check=False)
+    if result.returncode != 0:
+        sys.stderr.write(result.stderr)
+        print("error: freertos-trace.py failed", file=sys.stderr)
+        return 1
+
+    events = json.loads(result.stdout)["traceEvents"]
+    tracks = {e["tid"]: e["args"]["name"] for e in events
+              if e["ph"] == "M" and e["name"] == "thread_name"}
+
+    slices = {}
+    instants = []
+    for e in events:
+        if e["ph"] == "X":
+            slices.setdefault(tracks[e["tid"]], []).append(
+                (cycles(e["ts"]), cycles(e["dur"])))
+        elif e["ph"] == "i":
+            instants.append((tracks[e["tid"]], e["name"], cycles(e["ts"])))
+    slices = {name: sorted(s) for name, s in slices.items()}
+
+    failed = False
+    if slices != EXPECTED_SLICES:
+        print(f"error: slices\n  got      {slices}\n  expected {EXPECTED_SLICES}",
+              file=sys.stderr)
+        failed = True
+    if sorted(instants, key=lambda i: i[2]) != EXPECTED_INSTANTS:
+        print(f"error: instants\n  got      {instants}\n  expected {EXPECTED_INSTANTS}",
+              file=sys.stderr)
+        failed = True
+    if result.stderr != EXPECTED_SUMMARY:
+        print("error: summary\n" + result.stderr, file=sys.stderr)
+        failed = True
+
+    if failed:
+        return 1
+    print("freertos-trace: sample log OK")
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
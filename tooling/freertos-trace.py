@@ -0,0 +1,297 @@
+#!/usr/bin/env python3
+"""Convert a FreeRTOS trace-recorder port log to a Chrome trace.
+
+With make TRACE_RECORDER=1, the FreeRTOS demos write kernel events to two
+I/O ports (FreeRTOS/demos/trace.h): the event code to PORT and its
+payload to PORT+1.  This script reads a simulator's log of those OUT
+instructions (i8085-trace does not write one yet) and writes Chrome
+trace JSON, which chrome://tracing and ui.perfetto.dev open directly:
+
+  - one track per task, with a slice for each time it ran;
+  - one track per interrupt line (RST 5.5 / 6.5 tick / 7.5);
+  - queue, mutex and priority-inheritance events as instants on the
+    task or ISR that caused them.
+
+A summary goes to stderr: cycles per task, and count / mean / max cycles
+per interrupt line (tick-ISR bloat shows up here).
+
+Input is one OUT per line, "<cycle> <port> <value>", numbers in decimal
+or 0x-hex; blank lines and lines starting with '#' are skipped, as are
+writes to other ports.
+
+  freertos-trace.py out.log -o trace.json [--clock 3072000] [--port 0xF0]
+
+The tick's exit event is written when the interrupted task resumes.  If
+the tick switches to a task that last gave up the CPU by yielding or
+blocking, there is no exit event, and the tick slice ends at its task
+switch instead, just before the port restores the new context.
+
+The exit event comes after the port's EI (FreeRTOS/demos/startup.S), so
+a tick slice includes that 39 T-state tail.  Any event other than the
+tick's own switch ends an open tick, so a 5.5 or 7.5 taken in the tail
+closes it at its enter event and is not charged to the tick; the late
+exit is dropped.  freertos-trace-check.py checks these cases against a
+hand-made log.
+"""
+
+import argparse
+import json
+import sys
+
+EV_NAMES = {
+    0x03: "queue_create",
+    0x04: "mutex_create",
+    0x05: "queue_send",
+    0x06: "queue_send_failed",
+    0x07: "queue_receive",
+    0x08: "queue_receive_failed",
+    0x09: "blocking_on_send",
+    0x0A: "blocking_on_receive",
+    0x0B: "queue_send_from_isr",
+    0x0C: "queue_receive_from_isr",
+    0x0D: "priority_inherit",
+    0x0E: "priority_disinherit",
+}
+EV_TASK_CREATE = 0x01
+EV_TASK_SWITCHED_IN = 0x02
+EV_ISR_ENTER = 0x10
+EV_ISR_EXIT = 0x18
+PAYLOAD = {code: 2 for code in EV_NAMES}
+PAYLOAD.update({EV_TASK_SWITCHED_IN: 2, 0x0D: 3, 0x0E: 3})
+
+ISR_NAMES = {1: "RST 5.5", 2: "RST 6.5 (tick)", 3: "RST 7.5"}
+TICK_LEVEL = 2
+PID = 1
+
+
+def parse_int(text):
+    return int(text, 0)
+
+
+def read_log(path, port):
+    with open(path, "r", encoding="utf-8") as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            fields = line.split()
+            if len(fields) < 3:
+                raise SystemExit(f"{path}:{lineno}: expected '<cycle> <port> <value>'")
+            cycle, p, value = (parse_int(x) for x in fields[:3])
+            if p in (port, port + 1):
+                yield cycle, p - port, value & 0xFF
+
+
+def decode(writes):
+    """Yield (cycle, code, payload) records.
+
+    Payload-free ISR enter/exit codes may arrive between another event's
+    code and its payload (a higher interrupt nesting); they are reported
+    at once and the pending record carries on."""
+    pending = None  # [cycle, code, bytes]
+    for cycle, is_data, value in writes:
+        if not is_data:
+            if value >= EV_ISR_ENTER:
+                yield cycle, value, b""
+                continue
+            if pending is not None:
+                print(f"warning: cycle {pending[0]}: event 0x{pending[1]:02X} "
+                      "truncated", file=sys.stderr)
+            pending = [cycle, value, bytearray()]
+            if PAYLOAD.get(value) == 0:
+                yield cycle, value, b""
+                pending = None
+            continue
+
+        if pending is None:
+            print(f"warning: cycle {cycle}: stray payload byte", file=sys.stderr)
+            continue
+        cycle0, code, data = pending
+        data.append(value)
+        if code == EV_TASK_CREATE:
+            done = len(data) > 2 and value == 0
+        else:
+            done = len(data) >= PAYLOAD.get(code, 0)
+        if done:
+            yield cycle0, code, bytes(data)
+            pending = None
+
+
+class Converter:
+    def __init__(self, clock):
+        self.us_per_cycle = 1e6 / clock
+        self.events = []
+        self.tasks = {}         # TCB address -> (tid, name)
+        self.objects = {}       # queue address -> label
+        self.current = None     # running TCB
+        self.run_start = None
+        self.run_cycles = {}    # tid -> cycles
+        self.isr_open = []      # [(level, start)]
+        self.isr_stats = {}     # level -> [count, total, max]
+        self.tick_switch = None  # cycle of the task switch inside an open tick
+        self.last_cycle = 0
+
+    def ts(self, cycle):
+        return cycle * self.us_per_cycle
+
+    def task(self, tcb):
+        if tcb not in self.tasks:
+            self.tasks[tcb] = (100 + len(self.tasks), f"task@0x{tcb:04X}")
+        return self.tasks[tcb]
+
+    def obj_label(self, addr):
+        return self.objects.get(addr, f"queue@0x{addr:04X}")
+
+    def context_tid(self):
+        if self.isr_open:
+            return self.isr_open[-1][0]
+        if self.current is not None:
+            return self.task(self.current)[0]
+        return 0
+
+    def slice(self, tid, name, start, end):
+        self.events.append({"name": name, "ph": "X", "pid": PID, "tid": tid,
+                            "ts": self.ts(start), "dur": self.ts(end - start)})
+
+    def instant(self, tid, name, cycle, args):
+        self.events.append({"name": name, "ph": "i", "s": "t", "pid": PID,
+                            "tid": tid, "ts": self.ts(cycle), "args": args})
+
+    def isr_close(self, end):
+        level, start = self.isr_open.pop()
+        self.slice(level, ISR_NAMES.get(level, f"level {level}"), start, end)
+        stats = self.isr_stats.setdefault(level, [0, 0, 0])
+        stats[0] += 1
+        stats[1] += end - start
+        stats[2] = max(stats[2], end - start)
+        if level == TICK_LEVEL:
+            self.tick_switch = None
+
+    def tick_open(self):
+        return any(level == TICK_LEVEL for level, _ in self.isr_open)
+
+    def close_tick_without_exit(self, cycle):
+        """A tick with no exit event ends at its task switch."""
+        while self.isr_open and self.tick_open():
+            level, _ = self.isr_open[-1]
+            if level == TICK_LEVEL:
+                self.isr_close(self.tick_switch if self.tick_switch is not None
+                               else cycle)
+            else:
+                self.isr_close(cycle)
+
+    def switch_to(self, tcb, cycle):
+        if self.current is not None:
+            tid, name = self.task(self.current)
+            self.slice(tid, name, self.run_start, cycle)
+            self.run_cycles[tid] = self.run_cycles.get(tid, 0) + cycle - self.run_start
+        self.current = tcb
+        self.run_start = cycle
+        self.task(tcb)
+
+    def feed(self, cycle, code, data):
+        self.last_cycle = cycle
+
+        if code >= EV_ISR_EXIT:
+            level = code - EV_ISR_EXIT
+            if self.isr_open and self.isr_open[-1][0] == level:
+                self.isr_close(cycle)
+            # otherwise: a tick exit after a yield-type switch, no slice open
+            return
+
+        # Anything but the tick's own switch means the tick has ended
+        if self.tick_open() and not (code == EV_TASK_SWITCHED_IN
+                                     and self.tick_switch is None):
+            self.close_tick_without_exit(cycle)
+
+        if code >= EV_ISR_ENTER:
+            self.isr_open.append((code - EV_ISR_ENTER, cycle))
+            return
+
+        if code == EV_TASK_CREATE:
+            tcb = data[0] | data[1] << 8
+            name = data[2:-1].decode("ascii", "replace") or f"0x{tcb:04X}"
+            tid, _ = self.task(tcb)
+            self.tasks[tcb] = (tid, name)
+            return
+
+        if code == EV_TASK_SWITCHED_IN:
+            tcb = data[0] | data[1] << 8
+            if self.tick_open():
+                self.tick_switch = cycle
+            self.switch_to(tcb, cycle)
+            return
+
+        addr = data[0] | data[1] << 8
+        name = EV_NAMES.get(code, f"event_0x{code:02X}")
+        if code == 0x03:
+            self.objects.setdefault(addr, f"queue@0x{addr:04X}")
+        elif code == 0x04:
+            self.objects[addr] = f"mutex@0x{addr:04X}"
+        elif code in (0x0D, 0x0E):
+            tid, task_name = self.task(addr)
+            self.instant(tid, f"{name} {data[2]}", cycle,
+                         {"task": task_name, "priority": data[2]})
+            return
+        self.instant(self.context_tid(), name, cycle, {"object": self.obj_label(addr)})
+
+    def finish(self):
+        end = self.last_cycle
+        if self.tick_open():
+            self.close_tick_without_exit(end)
+        while self.isr_open:
+            self.isr_close(end)
+        if self.current is not None:
+            self.switch_to(self.current, end)
+
+        meta = [{"name": "process_name", "ph": "M", "pid": PID,
+                 "args": {"name": "i8085 FreeRTOS"}},
+                {"name": "thread_name", "ph": "M", "pid": PID, "tid": 0,
+                 "args": {"name": "startup"}}]
+        for level, name in ISR_NAMES.items():
+            meta.append({"name": "thread_name", "ph": "M", "pid": PID,
+                         "tid": level, "args": {"name": name}})
+        for tid, name in sorted(self.tasks.values()):
+            meta.append({"name": "thread_name", "ph": "M", "pid": PID,
+                         "tid": tid, "args": {"name": name}})
+        return {"traceEvents": meta + self.events, "displayTimeUnit": "ns"}
+
+    def summary(self, out):
+        out.write(f"{'task':<12} {'cycles':>12}\n")
+        for tid, name in sorted(self.tasks.values()):
+            out.write(f"{name:<12} {self.run_cycles.get(tid, 0):>12}\n")
+        out.write(f"\n{'interrupt':<16} {'count':>8} {'mean':>8} {'max':>8}\n")
+        for level in sorted(self.isr_stats):
+            count, total, worst = self.isr_stats[level]
+            out.write(f"{ISR_NAMES.get(level, level):<16} {count:>8} "
+                      f"{total // count:>8} {worst:>8}\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", help="OUT log: '<cycle> <port> <value>' per line")
+    parser.add_argument("-o", "--output", default="-",
+                        help="Chrome trace JSON (default: stdout)")
+    parser.add_argument("--port", type=parse_int, default=0xF0,
+                        help="traceRECORDER_PORT (default 0xF0)")
+    parser.add_argument("--clock", type=int, default=3072000,
+                        help="CPU clock in Hz for timestamps (default 3072000)")
+    args = parser.parse_args()
+
+    conv = Converter(args.clock)
+    for record in decode(read_log(args.log, args.port)):
+        conv.feed(*record)
+    trace = conv.finish()
+
+    if args.output == "-":
+        json.dump(trace, sys.stdout)
+        sys.stdout.write("\n")
+    else:
+        with open(args.output, "w", encoding="utf-8") as f:
+            json.dump(trace, f)
+    conv.summary(sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
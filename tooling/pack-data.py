@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""Compress the .data load image of an i8085 ROM binary.
+
+crt0 normally copies .data byte for byte from its load address (_sidata)
+to RAM.  When the program is linked with --defsym=__data_packed=1, crt0
+instead decodes a packed stream from _sidata.  This script produces that
+stream: it reads the linked ELF, compresses the .data contents, and writes
+a raw binary (as llvm-objcopy -O binary would) with the packed stream in
+place of the plain image.
+
+Stream format (decoded by _start in sysroot/crt/crt0.S):
+  0x00        end
+  0x01..0x7F  that many literal bytes follow
+  0x80..0xBF  run: the next byte stored (c & 0x3F) + 2 times
+  0xC0..0xFF  match: copy (c & 0x3F) + 3 bytes starting (next byte) + 1
+              bytes back in the output; may overlap the bytes it writes
+
+The .data load image must be the last thing in ROM (true for the ROM/RAM
+ldscripts in sysroot/ldscripts), since the packed binary ends with it.
+The packed image must end by __rom_end, which those ldscripts define as
+the end of the ROM region; --rom-end overrides it.
+
+Usage: pack-data.py program.elf program.bin [--base 0x0000] [--rom-end 0x10000]
+"""
+
+import argparse
+import struct
+import sys
+
+MAX_LIT = 0x7F
+MAX_RUN = 0x3F + 2
+MAX_MATCH = 0x3F + 3
+MAX_DIST = 0x100
+
+
+def compress(data: bytes) -> bytes:
+    """Greedy encoder for the crt0 stream format."""
+    out = bytearray()
+    lit = bytearray()
+
+    def flush():
+        while lit:
+            chunk = lit[:MAX_LIT]
+            out.append(len(chunk))
+            out.extend(chunk)
+            del lit[:MAX_LIT]
+
+    i = 0
+    n = len(data)
+    while i < n:
+        run = 1
+        while i + run < n and run < MAX_RUN and data[i + run] == data[i]:
+            run += 1
+
+        best_len, best_dist = 0, 0
+        for dist in range(1, min(MAX_DIST, i) + 1):
+            j = i - dist
+            k = 0
+            while i + k < n and k < MAX_MATCH and data[j + k] == data[i + k]:
+                k += 1
+            if k > best_len:
+                best_len, best_dist = k, dist
+                if k == MAX_MATCH:
+                    break
+
+        # A run costs 2 bytes, a match 2 bytes; take whichever covers more.
+        if best_len >= 3 and best_len >= run:
+            flush()
+            out.append(0xC0 | (best_len - 3))
+            out.append(best_dist - 1)
+            i += best_len
+        elif run >= 3 or (run == 2 and not lit):
+            flush()
+            out.append(0x80 | (run - 2))
+            out.append(data[i])
+            i += run
+        else:
+            lit.append(data[i])
+            i += 1
+    flush()
+    out.append(0)
+    return bytes(out)
+
+
+def decompress(stream: bytes) -> bytes:
+    """Reference decoder, mirroring crt0."""
+    out = bytearray()
+    i = 0
+    while True:
+        c = stream[i]
+        i += 1
+        if c == 0:
+            return bytes(out)
+        if c < 0x80:
+            out.extend(stream[i:i + c])
+            i += c
+        elif c < 0xC0:
+            out.extend(bytes([stream[i]]) * ((c & 0x3F) + 2))
+            i += 1
+        else:
+            src = len(out) - stream[i] - 1
+            i += 1
+            for k in range((c & 0x3F) + 3):
+                out.append(out[src + k])
+
+
+def read_elf(path):
+    """Return ({section name: (addr, bytes)}, {symbol: value})."""
+    with open(path, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF" or elf[4] != 1 or elf[5] != 1:
+        raise ValueError(f"{path}: not a 32-bit little-endian ELF")
+    (shoff,) = struct.unpack_from("<I", elf, 0x20)
+    shentsize, shnum, shstrndx = struct.unpack_from("<HHH", elf, 0x2E)
+    shdrs = [struct.unpack_from("<IIIIIIIIII", elf, shoff + k * shentsize)
+             for k in range(shnum)]
+
+    def cstr(off):
+        return elf[off:elf.index(b"\0", off)].decode()
+
+    strtab_off = shdrs[shstrndx][4]
+    sections, symbols = {}, {}
+    for name, type_, _, addr, off, size, link, _, _, entsize in shdrs:
+        if type_ == 1:  # SHT_PROGBITS
+            sections[cstr(strtab_off + name)] = (addr, elf[off:off + size])
+        elif type_ == 2:  # SHT_SYMTAB
+            names = shdrs[link][4]
+            for k in range(size // entsize):
+                st_name, st_value = struct.unpack_from("<II", elf, off + k * entsize)
+                if st_name:
+                    symbols[cstr(names + st_name)] = st_value
+    return sections, symbols
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf", help="linked program (with symbols)")
+    parser.add_argument("bin", help="raw binary to rewrite in place")
+    parser.add_argument("--base", type=lambda v: int(v, 0), default=0,
+                        help="address of the first byte of the binary")
+    parser.add_argument("--rom-end", type=lambda v: int(v, 0), default=None,
+                        help="first address past ROM (default: __rom_end)")
+    args = parser.parse_args()
+
+    sections, symbols = read_elf(args.elf)
+    for sym in ("_sidata", "_sdata", "_edata"):
+        if sym not in symbols:
+            print(f"error: {args.elf}: missing symbol {sym}", file=sys.stderr)
+            return 1
+    if not symbols.get("__data_packed"):
+        print("error: link with --defsym=__data_packed=1 so crt0 unpacks .data",
+              file=sys.stderr)
+        return 1
+    if symbols["_sidata"] == symbols["_sdata"]:
+        print("error: .data is linked in place (flat map); nothing to pack",
+              file=sys.stderr)
+        return 1
+
+    data = sections.get(".data", (0, b""))[1]
+    size = symbols["_edata"] - symbols["_sdata"]
+    data = data[:size].ljust(size, b"\0")
+    packed = compress(data)
+    assert decompress(packed) == data
+
+    with open(args.bin, "rb") as f:
+        image = f.read()
+    start = symbols["_sidata"] - args.base
+    if len(image) > start + size:
+        print("error: ROM contents follow the .data load image", file=sys.stderr)
+        return 1
+    image = image[:start].ljust(start, b"\xff") + packed
+    rom_end = args.rom_end
+    if rom_end is None:
+        rom_end = symbols.get("__rom_end") or 0x10000
+    if args.base + len(image) > rom_end:
+        print(f"error: packed image ends at {args.base + len(image):#06x}, "
+              f"past the end of ROM at {rom_end:#06x}", file=sys.stderr)
+        return 1
+    with open(args.bin, "wb") as f:
+        f.write(image)
+
+    print(f".data: {size} bytes -> {len(packed)} packed")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""Turn the most frequent helper calls into 1-byte RST instructions.
+
+RST n is a one-byte CALL to address 8*n.  crt0.S puts a JMP __rstN_target
+at each of RST 1..7; __rstN_target defaults to the isr_rstN interrupt
+handler and can be rebound at link time with --defsym.  Binding a helper
+such as __mul16 to a vector makes every `call __mul16` replaceable by
+`rst n`, saving 2 bytes per call site (and costing 4 cycles per call, for
+the extra JMP).
+
+  count    rank call targets by static call sites in compiler assembly
+           (clang -S) or llvm-objdump -d -t listings, assign the top ones
+           to the free vectors, and print the map
+  rewrite  apply a map to assembly files in place (between clang -S and
+           assembling)
+  defsyms  print the ld.lld --defsym options for a map
+
+Typical flow:
+  clang ... -S -o foo.s foo.c                 (every C file)
+  rst-calls.py count *.s > rst.map
+  rst-calls.py rewrite --map rst.map *.s
+  clang ... -c foo.s; ld.lld ... $(rst-calls.py defsyms --map rst.map)
+
+Only unconditional CALLs are rewritten; CZ/CNZ/... have no RST form.
+Vectors whose interrupt is in use must be left out with --vectors.
+
+Only calls to global symbols are counted or rewritten: .L* labels and
+names a file defines without .globl/.global (static functions) are left
+alone, since --defsym can only bind a vector to one global definition.
+In an assembly file a call target is global if the file declares it
+.globl or does not define it at all; in a listing, if the symbol table
+(-t) marks it global.
+"""
+
+import argparse
+import collections
+import re
+import sys
+
+CALL_ASM = re.compile(r"^(\s*)(call)\s+([A-Za-z_.$][\w.$]*)\s*$", re.I)
+CALL_LIST = re.compile(r"\bcall\b[^<]*<([^>+]+)>", re.I)
+GLOBL = re.compile(r"^\s*\.glob(?:a)?l\s+(.+)$", re.I)
+LABEL_ASM = re.compile(r"^\s*([A-Za-z_.$][\w.$]*):")
+LABEL_LIST = re.compile(r"^[0-9a-fA-F]+ <([^>]+)>:")
+SYMTAB = re.compile(r"^[0-9a-fA-F]+ ([lgu! ])[\w ]{6}\s+\S+\s+[0-9a-fA-F]+"
+                    r"\s+(?:\.hidden\s+)?(\S+)\s*$")
+
+
+def strip_comment(line):
+    return re.split(r"\s*(?:;|//|#)", line, maxsplit=1)[0]
+
+
+def scan_symbols(lines):
+    """Return (names declared global, names defined) for one file."""
+    globals_, defined = set(), set()
+    for line in lines:
+        m = SYMTAB.match(line)
+        if m:
+            (globals_ if m.group(1) in "gu" else defined).add(m.group(2))
+            continue
+        m = LABEL_LIST.match(line)
+        if m:
+            defined.add(m.group(1))
+            continue
+        line = strip_comment(line)
+        m = GLOBL.match(line)
+        if m:
+            globals_.update(s.strip() for s in m.group(1).split(","))
+            continue
+        m = LABEL_ASM.match(line)
+        if m:
+            defined.add(m.group(1))
+    return globals_, defined
+
+
+def is_global(sym, globals_, defined):
+    if sym.startswith(".L"):
+        return False
+    return sym in globals_ or sym not in defined
+
+
+def call_target(line):
+    m = CALL_LIST.search(line)
+    if m:
+        return m.group(1)
+    m = CALL_ASM.match(strip_comment(line))
+    return m.group(3) if m else None
+
+
+def count_calls(paths):
+    counts = collections.Counter()
+    for path in paths:
+        with open(path) as f:
+            lines = f.readlines()
+        globals_, defined = scan_symbols(lines)
+        for line in lines:
+            sym = call_target(line)
+            if sym and is_global(sym, globals_, defined):
+                counts[sym] += 1
+    return counts
+
+
+def read_map(path):
+    mapping = {}
+    with open(path) as f:
+        for line in f:
+            line = strip_comment(line).strip()
+            if line:
+                sym, vec = line.split()
+                mapping[sym] = int(vec)
+    return mapping
+
+
+def cmd_count(args):
+    vectors = [int(v) for v in args.vectors.split(",") if v]
+    if any(v < 1 or v > 7 for v in vectors):
+        print("error: vectors are RST 1..7", file=sys.stderr)
+        return 1
+    counts = count_calls(args.files)
+    top = [(s, n) for s, n in counts.most_common() if n >= args.min_sites]
+    print("# symbol  rst   (call sites, bytes saved)")
+    for vec, (sym, n) in zip(vectors, top):
+        print(f"{sym} {vec}   # {n} sites, {2 * n} bytes")
+    return 0
+
+
+def cmd_rewrite(args):
+    mapping = read_map(args.map)
+    total = 0
+    for path in args.files:
+        with open(path) as f:
+            lines = f.readlines()
+        globals_, defined = scan_symbols(lines)
+        changed = 0
+        for i, line in enumerate(lines):
+            m = CALL_ASM.match(strip_comment(line.rstrip("\n")))
+            if (m and m.group(3) in mapping
+                    and is_global(m.group(3), globals_, defined)):
+                rst = "RST" if m.group(2).isupper() else "rst"
+                lines[i] = f"{m.group(1)}{rst} {mapping[m.group(3)]}\n"
+                changed += 1
+        if changed:
+            with open(path, "w") as f:
+                f.writelines(lines)
+        total += changed
+    print(f"rewrote {total} call sites ({2 * total} bytes)", file=sys.stderr)
+    return 0
+
+
+def cmd_defsyms(args):
+    mapping = read_map(args.map)
+    print(" ".join(f"--defsym=__rst{vec}_target={sym}"
+                   for sym, vec in sorted(mapping.items(), key=lambda kv: kv[1])))
+    return 0
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    p = sub.add_parser("count", help="rank call targets and print a map")
+    p.add_argument("files", nargs="+", help=".s files or objdump listings")
+    p.add_argument("--vectors", default="1,2,3,4,5,6,7",
+                   help="free RST vectors, in assignment order")
+    p.add_argument("--min-sites", type=int, default=2,
+                   help="skip targets with fewer call sites")
+    p.set_defaults(fn=cmd_count)
+
+    p = sub.add_parser("rewrite", help="rewrite call sites in .s files")
+    p.add_argument("--map", required=True)
+    p.add_argument("files", nargs="+")
+    p.set_defaults(fn=cmd_rewrite)
+
+    p = sub.add_parser("defsyms", help="print the ld.lld options for a map")
+    p.add_argument("--map", required=True)
+    p.set_defaults(fn=cmd_defsyms)
+
+    args = parser.parse_args()
+    return args.fn(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())